@@ -0,0 +1,528 @@
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <functional>
+#include <unordered_map>
+#include "OrderBook.h"
+#include "PerfCounters.h"
+
+/*
+Benchmarks, build from the repository root
+
+g++ -std=c++20 -O2 -I. Benchmark/Benchmark.cpp OrderBook.cpp TradeLog.cpp MemoryArena.cpp PerfCounters.cpp -o benchmark
+*/
+
+using Clock = std::chrono::steady_clock;
+
+struct BookShape {
+    std::size_t orders_;
+    Price levels_;      // Levels per side
+    OwnerId owners_;
+};
+
+struct RestingOrder {
+    OrderId orderId_;
+    Side side_;
+    Price price_;
+    OwnerId owner_;
+};
+
+// Resting book without crossing prices, bids below 10000 and asks from 10001 upwards.
+// Ids are shuffled so that id order says nothing about where an order lives in memory,
+// as it would be after a session of churn.
+std::vector<RestingOrder> MakeOrders(const BookShape& shape) {
+    std::mt19937 generator {42};
+    std::vector<RestingOrder> orders;
+    OrderIds ids(shape.orders_);
+    std::iota(ids.begin(), ids.end(), OrderId{1});
+    std::shuffle(ids.begin(), ids.end(), generator);
+
+    for (std::size_t i = 0; i < shape.orders_; i++) {
+        Side side = i % 2 == 0 ? Side::Buy : Side::Sell;
+        Price offset = static_cast<Price>(generator() % shape.levels_);
+        Price price = side == Side::Buy ? 10000 - offset : 10001 + offset;
+        OwnerId owner = 1 + static_cast<OwnerId>(generator() % shape.owners_);
+        orders.push_back(RestingOrder{ids[i], side, price, owner});
+    }
+    return orders;
+}
+
+void FillBook(Orderbook& orderbook, const std::vector<RestingOrder>& orders) {
+    for (const auto& [orderId, side, price, owner] : orders)
+        orderbook.AddOrder(Order{OrderType::GoodUntilCancel, orderId, side, price, 10, owner});
+}
+
+// Ids a predicate selects in ascending order, as a client would track them, used to drive the CancelOrder loop
+OrderIds SelectIds(const std::vector<RestingOrder>& orders, const std::function<bool(Side, Price, OwnerId)>& selected) {
+    OrderIds ids;
+    for (const auto& [orderId, side, price, owner] : orders)
+        if (selected(side, price, owner))
+            ids.push_back(orderId);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+double MeasureMicroseconds(const std::function<void()>& function) {
+    auto start = Clock::now();
+    function();
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+void BenchmarkMassCancel() {
+    const BookShape shape {200000, 500, 64};
+
+    struct Case {
+        const char* name_;
+        std::function<bool(Side, Price, OwnerId)> selected_;
+        std::function<OrderIds(Orderbook&)> massCancel_;
+    };
+
+    const std::vector<Case> cases {
+        {"All", [](Side, Price, OwnerId) { return true; },
+            [](Orderbook& orderbook) { return orderbook.MassCancel(); }},
+        {"Side", [](Side side, Price, OwnerId) { return side == Side::Buy; },
+            [](Orderbook& orderbook) { return orderbook.MassCancel(Side::Buy); }},
+        {"PriceRange", [](Side side, Price price, OwnerId) { return side == Side::Sell && price >= 10050 && price <= 10150; },
+            [](Orderbook& orderbook) { return orderbook.MassCancel(Side::Sell, 10050, 10150); }},
+        {"Owner", [](Side, Price, OwnerId owner) { return owner == 7; },
+            [](Orderbook& orderbook) { return orderbook.MassCancel(OwnerId{7}); }},
+    };
+
+    std::cout << std::format("\nMass cancel, {} resting orders, {} levels per side, {} owners\n", shape.orders_, shape.levels_, shape.owners_);
+    std::cout << std::format("{:<12}{:>10}{:>16}{:>16}{:>10}\n", "Scope", "Orders", "Loop (us)", "Mass (us)", "Speedup");
+
+    const auto orders = MakeOrders(shape);
+
+    for (const auto& [name, selected, massCancel] : cases) {
+        OrderIds ids = SelectIds(orders, selected);
+
+        Orderbook loopBook;
+        FillBook(loopBook, orders);
+        double loop = MeasureMicroseconds([&] {
+            for (auto orderId : ids)
+                loopBook.CancelOrder(orderId);
+        });
+
+        Orderbook massBook;
+        FillBook(massBook, orders);
+        OrderIds cancelled;
+        double mass = MeasureMicroseconds([&] { cancelled = massCancel(massBook); });
+
+        if (cancelled.size() != ids.size() || loopBook.Size() != massBook.Size())
+            throw std::logic_error(std::format("Mass cancel {} disagrees with the CancelOrder loop", name));
+
+        std::cout << std::format("{:<12}{:>10}{:>16.0f}{:>16.0f}{:>9.1f}x\n", name, ids.size(), loop, mass, loop / mass);
+    }
+}
+
+// Mixed flow around a narrow spread, per operation counters from PerfRecorder
+void BenchmarkOperations() {
+    constexpr std::size_t Commands = 500000;
+
+    PerfRecorder recorder;
+    Orderbook orderbook;
+    orderbook.SetVerbose(false);
+    orderbook.SetRecorder(&recorder);
+
+    std::mt19937 generator {7};
+    OrderIds live;
+    OrderId nextId {1};
+
+    for (std::size_t i = 0; i < Commands; i++) {
+        auto action = generator() % 10;
+        if (action < 6 || live.empty()) {
+            Side side = generator() % 2 == 0 ? Side::Buy : Side::Sell;
+            Price price = 1000 + static_cast<Price>(generator() % 40) - 20;
+            orderbook.AddOrder(Order{OrderType::GoodUntilCancel, nextId, side, price, 1 + static_cast<Quantity>(generator() % 100)});
+            live.push_back(nextId++);
+        } else {
+            std::size_t index = generator() % live.size();
+            OrderId orderId = live[index];
+            live[index] = live.back();
+            live.pop_back();
+
+            if (action < 9) {
+                orderbook.CancelOrder(orderId);
+            } else {
+                Side side = generator() % 2 == 0 ? Side::Buy : Side::Sell;
+                Price price = 1000 + static_cast<Price>(generator() % 40) - 20;
+                orderbook.ModifyOrder(OrderModify(orderId, side, price, 1 + static_cast<Quantity>(generator() % 100)));
+                live.push_back(orderId);
+            }
+        }
+    }
+
+    std::cout << std::format("\nOperations, {} mixed commands\n", Commands);
+    recorder.Print();
+}
+
+// One aggressive order walking deep queues. Orders of different levels arrive interleaved,
+// as they would in a live session, so a level's orders are not adjacent by construction.
+void BenchmarkDeepQueueSweep() {
+    constexpr std::size_t Orders = 400000;
+    constexpr Price Levels = 50;
+
+    PerfRecorder recorder;
+    Orderbook orderbook;
+    orderbook.SetVerbose(false);
+
+    for (std::size_t i = 0; i < Orders; i++) {
+        Price price = 2000 + static_cast<Price>(i % Levels);
+        orderbook.AddOrder(Order{OrderType::GoodUntilCancel, static_cast<OrderId>(i + 1), Side::Sell, price, 10});
+    }
+
+    orderbook.SetRecorder(&recorder);
+    auto trades = orderbook.AddOrder(Order{OrderType::GoodUntilCancel, static_cast<OrderId>(Orders + 1), Side::Buy, 2000 + Levels, static_cast<Quantity>(Orders * 10)});
+    orderbook.SetRecorder(nullptr);
+
+    const auto& stats = recorder.GetStats(BookOperation::Match);
+    auto PerOrder = [&](PerfCounter counter) {
+        return recorder.HasCounter(counter) ? std::format("{:.2f}", static_cast<double>(stats.total_.Get(counter)) / trades.size()) : std::string {"-"};
+    };
+
+    std::cout << std::format("\nDeep queue sweep, {} resting orders over {} levels\n", Orders, Levels);
+    std::cout << std::format("{:>10}{:>14}{:>14}{:>14}{:>14}\n", "Fills", "ns/fill", "cycles/fill", "cache/fill", "dtlb/fill");
+    std::cout << std::format("{:>10}{:>14.1f}{:>14}{:>14}{:>14}\n", trades.size(),
+        static_cast<double>(stats.total_.nanoseconds_) / trades.size(),
+        PerOrder(PerfCounter::Cycles), PerOrder(PerfCounter::CacheMisses), PerOrder(PerfCounter::DtlbMisses));
+
+    // The layout is about misses, timing alone does not show whether it saves any
+    if (!recorder.HasCounter(PerfCounter::CacheMisses) || !recorder.HasCounter(PerfCounter::DtlbMisses))
+        std::cout << "Cache or dTLB counters unavailable on this host, misses not measured\n";
+}
+
+// Icebergs resting on one side and a stream of small aggressive orders eating their tranches.
+// Native icebergs refill in place, the emulation adds a new order for every tranche as a client would.
+void BenchmarkIcebergChurn() {
+    constexpr std::size_t Icebergs = 1000;
+    constexpr std::size_t Aggressors = 200000;
+    constexpr Quantity Total = 10000;
+    constexpr Quantity Display = 10;
+
+    struct Child {
+        std::size_t iceberg_;
+        Quantity remaining_;
+    };
+
+    auto Run = [&](bool native, std::size_t& trades, std::size_t& refills) {
+        Orderbook orderbook;
+        orderbook.SetVerbose(false);
+        std::vector<Quantity> reserves(Icebergs, Total - Display);
+        std::unordered_map<OrderId, Child> children;
+        OrderId nextId {1};
+
+        for (std::size_t i = 0; i < Icebergs; i++) {
+            Price price = 1000 + static_cast<Price>(i % 10);
+            if (native) {
+                orderbook.AddOrder(Order{OrderType::GoodUntilCancel, nextId++, Side::Sell, price, Total, Constants::NoOwner, Display});
+            } else {
+                children[nextId] = Child{i, Display};
+                orderbook.AddOrder(Order{OrderType::GoodUntilCancel, nextId++, Side::Sell, price, Display});
+            }
+        }
+
+        std::mt19937 generator {11};
+        trades = refills = 0;
+
+        return MeasureMicroseconds([&] {
+            for (std::size_t i = 0; i < Aggressors; i++) {
+                Quantity quantity = 1 + static_cast<Quantity>(generator() % 20);
+                auto filled = orderbook.AddOrder(Order{OrderType::FillAndKill, nextId++, Side::Buy, 1009, quantity});
+                trades += filled.size();
+
+                if (native)
+                    continue;
+
+                for (const auto& trade : filled) {
+                    const auto& [orderId, _, traded] = trade.GetAskTrade();
+                    auto child = children.find(orderId);
+                    if ((child->second.remaining_ -= traded) != 0)
+                        continue;
+
+                    auto iceberg = child->second.iceberg_;
+                    children.erase(child);
+                    if (reserves[iceberg] == 0)
+                        continue;
+
+                    Quantity tranche = std::min(Display, reserves[iceberg]);
+                    reserves[iceberg] -= tranche;
+                    children[nextId] = Child{iceberg, tranche};
+                    orderbook.AddOrder(Order{OrderType::GoodUntilCancel, nextId++, Side::Sell, 1000 + static_cast<Price>(iceberg % 10), tranche});
+                    refills++;
+                }
+            }
+        });
+    };
+
+    std::cout << std::format("\nIceberg churn, {} icebergs of {} showing {}, {} aggressive orders\n", Icebergs, Total, Display, Aggressors);
+    std::cout << std::format("{:<12}{:>14}{:>12}{:>12}\n", "Refill", "ns/order", "Trades", "Refills");
+
+    std::size_t trades {}, refills {};
+    double emulated = Run(false, trades, refills);
+    std::cout << std::format("{:<12}{:>14.1f}{:>12}{:>12}\n", "Re-add", emulated * 1000 / Aggressors, trades, refills);
+
+    double native = Run(true, trades, refills);
+    std::cout << std::format("{:<12}{:>14.1f}{:>12}{:>12}\n", "Native", native * 1000 / Aggressors, trades, "-");
+}
+
+// Queries over a large trade log, against the same scans over the Trades vectors the engine returns
+void BenchmarkTradeLog() {
+    constexpr std::size_t Fills = 4000000;
+
+    TradeLog log {Fills};
+    Trades rows;
+    rows.reserve(Fills);
+    std::vector<Timestamp> timestamps;
+    timestamps.reserve(Fills);
+
+    std::mt19937 generator {13};
+    Timestamp timestamp {};
+    while (rows.size() < Fills) {
+        Trades trades;
+        timestamp += generator() % 2000;
+        for (auto fills = 1 + generator() % 4; fills > 0 && rows.size() + trades.size() < Fills; fills--) {
+            Price price = 10000 + static_cast<Price>(generator() % 200);
+            Quantity quantity = 1 + static_cast<Quantity>(generator() % 100);
+            trades.push_back(Trade{TradeInfo{1 + generator() % 100000, price, quantity}, TradeInfo{1 + generator() % 100000, price, quantity}});
+        }
+        log.Append(trades, Side::Buy, timestamp);
+        rows.insert(rows.end(), trades.begin(), trades.end());
+        timestamps.insert(timestamps.end(), trades.size(), timestamp);
+    }
+
+    const TimeWindow window {timestamp / 4, timestamp / 4 * 3};
+    auto first = static_cast<std::size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), window.from_) - timestamps.begin());
+    auto last = static_cast<std::size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), window.to_) - timestamps.begin());
+    const OrderId orderId = rows[Fills / 2].GetBidTrade().orderId_;
+
+    std::cout << std::format("\nTrade log, {} fills, queries over the middle half\n", Fills);
+    std::cout << std::format("{:<18}{:>14}{:>14}\n", "Query", "Trades (us)", "Log (us)");
+
+    double vwap {}, expected {};
+    double scan = MeasureMicroseconds([&] {
+        Volume notional {}, volume {};
+        for (std::size_t row = first; row < last; row++) {
+            const auto& [_, price, quantity] = rows[row].GetBidTrade();
+            notional += static_cast<Volume>(price) * quantity;
+            volume += quantity;
+        }
+        expected = static_cast<double>(notional) / static_cast<double>(volume);
+    });
+    double query = MeasureMicroseconds([&] { vwap = log.GetVwap(window).value_or(0); });
+    if (vwap != expected)
+        throw std::logic_error("Trade log VWAP disagrees with the scan");
+    std::cout << std::format("{:<18}{:>14.0f}{:>14.0f}\n", "Vwap", scan, query);
+
+    Volume filled {}, expectedFilled {};
+    scan = MeasureMicroseconds([&] {
+        for (std::size_t row = first; row < last; row++)
+            if (rows[row].GetBidTrade().orderId_ == orderId || rows[row].GetAskTrade().orderId_ == orderId)
+                expectedFilled += rows[row].GetBidTrade().quantity_;
+    });
+    query = MeasureMicroseconds([&] { filled = log.GetFilledQuantity(orderId, window); });
+    if (filled != expectedFilled)
+        throw std::logic_error("Trade log fill total disagrees with the scan");
+    std::cout << std::format("{:<18}{:>14.0f}{:>14.0f}\n", "FilledQuantity", scan, query);
+
+    std::size_t results {};
+    query = MeasureMicroseconds([&] { results = log.GetVolumeByPrice(10, window).size(); });
+    std::cout << std::format("{:<18}{:>14}{:>14.0f}\n", "VolumeByPrice", "-", query);
+
+    query = MeasureMicroseconds([&] { results = log.GetBars(1000000, window).size(); });
+    std::cout << std::format("{:<18}{:>14}{:>14.0f}\n", "Bars (1ms)", "-", query);
+
+    query = MeasureMicroseconds([&] { results = log.GetFillTotals(window).size(); });
+    std::cout << std::format("{:<18}{:>14}{:>14.0f}\n", "FillTotals", "-", query);
+}
+
+// Reading the signals after every event of a flow over a deep book, against deriving them from GetOrderInfos
+void BenchmarkSignals() {
+    constexpr std::size_t Events = 200000;
+    constexpr std::size_t RebuildEvents = 2000;     // Every rebuild walks the whole book
+    const BookShape shape {50000, 200, 64};
+
+    auto Run = [&](bool rebuild, std::size_t events) {
+        Orderbook orderbook;
+        orderbook.SetVerbose(false);
+        FillBook(orderbook, MakeOrders(shape));
+
+        std::mt19937 generator {17};
+        OrderId nextId = shape.orders_ + 1;
+        double checksum {};
+
+        double elapsed = MeasureMicroseconds([&] {
+            for (std::size_t i = 0; i < events; i++) {
+                Side side = generator() % 2 == 0 ? Side::Buy : Side::Sell;
+                Price offset = static_cast<Price>(generator() % 20);
+                Price price = side == Side::Buy ? 10000 - offset : 10001 + offset;
+                if (generator() % 3 == 0) {
+                    orderbook.CancelOrder(1 + generator() % (nextId - 1));
+                } else {
+                    orderbook.AddOrder(Order{OrderType::GoodUntilCancel, nextId++, side, price, 1 + static_cast<Quantity>(generator() % 20)});
+                }
+
+                if (!rebuild) {
+                    checksum += orderbook.GetSignals().imbalance_.value_or(0);
+                    continue;
+                }
+
+                auto infos = orderbook.GetOrderInfos();
+                double bid {}, ask {};
+                for (std::size_t level = 0; level < Orderbook::SignalLevels && level < infos.GetBids().size(); level++)
+                    bid += infos.GetBids()[level].quantity_;
+                for (std::size_t level = 0; level < Orderbook::SignalLevels && level < infos.GetAsks().size(); level++)
+                    ask += infos.GetAsks()[level].quantity_;
+                checksum += bid + ask > 0 ? (bid - ask) / (bid + ask) : 0;
+            }
+        });
+        return std::pair {elapsed * 1000 / events, checksum};
+    };
+
+    std::cout << std::format("\nSignals after every event, {} resting orders, {} events ({} through GetOrderInfos)\n", shape.orders_, Events, RebuildEvents);
+    std::cout << std::format("{:<16}{:>14}\n", "Source", "ns/event");
+
+    auto [rebuild, expected] = Run(true, RebuildEvents);
+    if (std::abs(Run(false, RebuildEvents).second - expected) > 1e-6 * RebuildEvents)
+        throw std::logic_error("Maintained imbalance disagrees with GetOrderInfos");
+    auto [maintained, _] = Run(false, Events);
+
+    std::cout << std::format("{:<16}{:>14.1f}\n", "GetOrderInfos", rebuild);
+    std::cout << std::format("{:<16}{:>14.1f}\n", "GetSignals", maintained);
+}
+
+// Same resting book and flow for every matching policy: a deep ask side refilled by passive
+// orders and fill and kill buys sized to consume about what arrives. Pro-rata fills every
+// order of a level it reaches, FIFO only the front ones.
+template <typename Policy>
+void BenchmarkPolicy(const char* name) {
+    using Book = BasicOrderbook<DefaultTraits, Policy>;
+    constexpr std::size_t Resting = 5000;
+    constexpr std::size_t Commands = 400000;
+    constexpr Price Levels = 10;
+
+    Book orderbook;
+    orderbook.SetVerbose(false);
+    std::mt19937 generator {5};
+    OrderId nextId {1};
+
+    auto AddPassive = [&] {
+        Price price = 3000 + static_cast<Price>(generator() % Levels);
+        orderbook.AddOrder(typename Book::Order{OrderType::GoodUntilCancel, nextId++, Side::Sell, price, 1 + static_cast<Quantity>(generator() % 100)});
+    };
+
+    for (std::size_t i = 0; i < Resting; i++)
+        AddPassive();
+
+    std::size_t aggressors {}, trades {};
+    double elapsed = MeasureMicroseconds([&] {
+        for (std::size_t i = 0; i < Commands; i++) {
+            if (i % 2 == 0) {
+                AddPassive();
+                continue;
+            }
+            auto filled = orderbook.AddOrder(typename Book::Order{OrderType::FillAndKill, nextId++, Side::Buy, 3000 + Levels, 1 + static_cast<Quantity>(generator() % 100)});
+            aggressors++;
+            trades += filled.size();
+        }
+    });
+
+    std::cout << std::format("{:<20}{:>14.1f}{:>14.1f}{:>14.1f}\n", name, elapsed * 1000 / Commands,
+        static_cast<double>(trades) / aggressors, elapsed * 1000 / std::max<std::size_t>(trades, 1));
+}
+
+void BenchmarkMatchingPolicies() {
+    std::cout << "\nMatching policies, 5000 resting asks over 10 levels then 400000 commands, half fill and kill buys\n";
+    std::cout << std::format("{:<20}{:>14}{:>14}{:>14}\n", "Policy", "ns/cmd", "Fills/buy", "ns/fill");
+
+    BenchmarkPolicy<FifoPolicy>("Fifo");
+    BenchmarkPolicy<ProRataPolicy>("ProRata");
+    BenchmarkPolicy<TopOrderProRataPolicy>("TopOrderProRata");
+}
+
+// Counts the bytes an orderbook holds, to compare the footprint of instrument traits
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t GetInUse() const { return inUse_; }
+    std::size_t GetHighWater() const { return highWater_; }
+
+private:
+    std::pmr::memory_resource* upstream_ {std::pmr::new_delete_resource()};
+    std::size_t inUse_ {};
+    std::size_t highWater_ {};
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        inUse_ += bytes;
+        highWater_ = std::max(highWater_, inUse_);
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override {
+        inUse_ -= bytes;
+        upstream_->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// Same resting book and mixed flow for every traits variant, prices stay within 16 bits
+template <typename Traits>
+void BenchmarkTraits(const char* name) {
+    using Book = BasicOrderbook<Traits>;
+    constexpr std::size_t Commands = 500000;
+    const BookShape shape {200000, 500, 64};
+
+    CountingResource resource;
+    Book orderbook {&resource};
+    orderbook.SetVerbose(false);
+
+    for (const auto& [orderId, side, price, owner] : MakeOrders(shape))
+        orderbook.AddOrder(typename Book::Order{OrderType::GoodUntilCancel, orderId, side, static_cast<typename Traits::Price>(price), 10, owner});
+    std::size_t resting = resource.GetInUse();
+
+    std::mt19937 generator {7};
+    OrderId nextId = shape.orders_ + 1;
+    std::size_t trades {};
+
+    double elapsed = MeasureMicroseconds([&] {
+        for (std::size_t i = 0; i < Commands; i++) {
+            Side side = generator() % 2 == 0 ? Side::Buy : Side::Sell;
+            auto price = static_cast<typename Traits::Price>(10000 + static_cast<int>(generator() % 41) - 20);
+            auto quantity = static_cast<typename Traits::Quantity>(1 + generator() % 100);
+
+            if (generator() % 4 == 0 && nextId > shape.orders_ + 1) {
+                orderbook.CancelOrder(shape.orders_ + 1 + generator() % (nextId - shape.orders_ - 1));
+            } else {
+                trades += orderbook.AddOrder(typename Book::Order{OrderType::GoodUntilCancel, nextId++, side, price, quantity}).size();
+            }
+        }
+    });
+
+    std::cout << std::format("{:<14}{:>8}{:>8}{:>10}{:>14.1f}{:>14.1f}{:>12.1f}{:>10}\n", name,
+        sizeof(typename Traits::Price), sizeof(typename Traits::Quantity), sizeof(OrderNode<Traits>),
+        static_cast<double>(resting) / shape.orders_, static_cast<double>(resource.GetHighWater()) / (1024 * 1024),
+        elapsed * 1000 / Commands, trades);
+}
+
+void BenchmarkInstrumentTraits() {
+    std::cout << "\nInstrument traits, 200000 resting orders then 500000 mixed commands\n";
+    std::cout << std::format("{:<14}{:>8}{:>8}{:>10}{:>14}{:>14}{:>12}{:>10}\n",
+        "Traits", "Price", "Qty", "Node", "Bytes/order", "Peak (MB)", "ns/cmd", "Trades");
+
+    BenchmarkTraits<DefaultTraits>("Default");
+    BenchmarkTraits<WideQuantityTraits>("WideQuantity");
+    BenchmarkTraits<CompactPriceTraits>("CompactPrice");
+}
+
+int main() {
+    BenchmarkMassCancel();
+    BenchmarkOperations();
+    BenchmarkDeepQueueSweep();
+    BenchmarkIcebergChurn();
+    BenchmarkInstrumentTraits();
+    BenchmarkTradeLog();
+    BenchmarkSignals();
+    BenchmarkMatchingPolicies();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <optional>
+
+/*
+Pricing signals derived from the top of the book
+
+Maintained by the orderbook as level aggregates change, reading them costs nothing.
+A signal is empty while the book does not have the levels it needs.
+*/
+
+struct BookSignals {
+    std::optional<double> microprice_;          // Best prices weighted by the opposite side's quantity
+    std::optional<double> imbalance_;           // (bid - ask) / (bid + ask) quantity over the top levels, in [-1, 1]
+    std::optional<double> depthWeightedMid_;    // Mean of the bid and ask VWAPs over the top levels
+};
\ No newline at end of file
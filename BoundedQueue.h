@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*
+Blocking queue of bounded capacity between two pipeline stages
+
+Push blocks while the queue is full and Pop while it is empty, so a fast producer is held
+back by a slow consumer instead of buffering without limit. Close wakes both sides: Push
+fails from then on, Pop drains what is left and then fails.
+*/
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity)
+        : capacity_ {capacity}
+    { }
+    BoundedQueue(const BoundedQueue&) = delete;         // Copy constructor
+    void operator=(const BoundedQueue&) = delete;       // Copy assignment
+    BoundedQueue(BoundedQueue&&) = delete;              // Move constructor
+    void operator=(BoundedQueue&&) = delete;            // Move assignment
+
+    bool Push(T item) {
+        {
+            std::unique_lock lock {mutex_};
+            notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+            if (closed_)
+                return false;
+            items_.push_back(std::move(item));
+        }
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    bool Pop(T& item) {
+        {
+            std::unique_lock lock {mutex_};
+            notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty())
+                return false;
+            item = std::move(items_.front());
+            items_.pop_front();
+        }
+        notFull_.notify_one();
+        return true;
+    }
+
+    bool TryPop(T& item) {
+        {
+            std::lock_guard lock {mutex_};
+            if (items_.empty())
+                return false;
+            item = std::move(items_.front());
+            items_.pop_front();
+        }
+        notFull_.notify_one();
+        return true;
+    }
+
+    void Close() {
+        {
+            std::lock_guard lock {mutex_};
+            closed_ = true;
+        }
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+private:
+    std::size_t capacity_;
+    std::deque<T> items_;           // Guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    bool closed_ {false};           // Guarded by mutex_
+};
@@ -9,10 +9,55 @@ enum class Side {
     Sell
 };
 
-using Price = std::int32_t;
-using Quantity = std::int32_t;
 using OrderId = std::uint64_t;
+using OrderIds = std::vector<OrderId>;
+using OwnerId = std::uint32_t;  // Session or client owning an order
+
+/*
+Instrument traits
+
+Fix the representation of an orderbook's prices and quantities at compile time. Prices are
+integers on a grid of TickSize, the lowest representable price is reserved as the invalid
+price so a market order never aliases a real level.
+*/
+template <typename PriceType, typename QuantityType, PriceType Tick = 1>
+struct InstrumentTraits {
+    static_assert(std::numeric_limits<PriceType>::is_integer && std::numeric_limits<PriceType>::is_signed, "Price must be a signed integer");
+    static_assert(std::numeric_limits<QuantityType>::is_integer && std::numeric_limits<QuantityType>::is_signed, "Quantity must be a signed integer");
+    static_assert(Tick > 0, "Tick size must be positive");
+
+    using Price = PriceType;
+    using Quantity = QuantityType;
+
+    static constexpr Price TickSize = Tick;
+    static constexpr Price InvalidPrice = std::numeric_limits<Price>::min();
+
+    // Snap a price onto the tick grid, buys round down and sells round up so neither becomes more aggressive
+    static constexpr Price NormalizePrice(Side side, Price price) {
+        if constexpr (TickSize == 1) {
+            return price;
+        } else {
+            if (price == InvalidPrice)
+                return price;
+
+            Price offset = static_cast<Price>(price % TickSize);
+            if (offset < 0)
+                offset = static_cast<Price>(offset + TickSize);
+            if (offset == 0)
+                return price;
+            return static_cast<Price>(side == Side::Buy ? price - offset : price - offset + TickSize);
+        }
+    }
+};
+
+using DefaultTraits = InstrumentTraits<std::int32_t, std::int32_t>;
+using WideQuantityTraits = InstrumentTraits<std::int32_t, std::int64_t>;    // Quantities that overflow 32 bits once summed
+using CompactPriceTraits = InstrumentTraits<std::int16_t, std::int32_t>;    // Prices as 16 bit tick offsets
+
+using Price = DefaultTraits::Price;
+using Quantity = DefaultTraits::Quantity;
 
 struct Constants {
-    static const Price InvalidPrice = std::numeric_limits<Price>::quiet_NaN();
+    static constexpr Price InvalidPrice = DefaultTraits::InvalidPrice;
+    static constexpr OwnerId NoOwner = 0;
 };
\ No newline at end of file
@@ -0,0 +1,194 @@
+#include "DepthRenderer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <format>
+#include <stdexcept>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+    constexpr const char* Red = "\033[1;31m";
+    constexpr const char* Green = "\033[1;32m";
+    constexpr const char* Yellow = "\033[1;33m";
+    constexpr const char* Reset = "\033[0m";
+    constexpr const char* Block = "█";
+
+    // Right aligned in width columns
+    template <typename Number>
+    void AppendNumber(std::string& output, Number number, std::size_t width = 0) {
+        char buffer[24];
+        auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        auto length = static_cast<std::size_t>(end - buffer);
+        if (length < width)
+            output.append(width - length, ' ');
+        output.append(buffer, end);
+    }
+
+    void AppendCursor(std::string& output, std::size_t row) {
+        output += "\033[";
+        AppendNumber(output, row);
+        output += ";1H";
+    }
+}
+
+DepthRenderer::DepthRenderer(int outputFd, std::size_t depth, std::chrono::milliseconds interval)
+    : outputFd_ {outputFd},
+      interval_ {interval}
+{
+    winsize size {};
+    terminalRows_ = ioctl(outputFd_, TIOCGWINSZ, &size) == 0 && size.ws_row != 0 ? size.ws_row : 24;
+
+    // The pane never takes the rows the console needs for its prompts
+    std::size_t fitting = terminalRows_ > ConsoleRows + 5 ? (terminalRows_ - ConsoleRows - 3) / 2 : 1;
+    depth_ = std::clamp<std::size_t>(depth, 1, fitting);
+
+    bids_.resize(depth_);
+    asks_.resize(depth_);
+    rows_.resize(PaneRows());
+    for (auto& row : rows_)
+        row.reserve(RowBytes);
+    row_.reserve(RowBytes);
+    frame_.reserve(PaneRows() * (RowBytes + 16) + 64);
+}
+
+DepthRenderer::~DepthRenderer() {
+    if (!started_)
+        return;
+
+    // Whole screen scrolls again, the console continues below the pane
+    frame_.clear();
+    frame_ += "\033[r";
+    AppendCursor(frame_, terminalRows_);
+    frame_ += '\n';
+    [[maybe_unused]] auto written = write(outputFd_, frame_.data(), frame_.size());
+}
+
+bool DepthRenderer::Render(const Orderbook& orderbook, bool force) {
+    auto now = std::chrono::steady_clock::now();
+    if (!force && started_ && now - lastFrame_ < interval_) {
+        pending_ = true;
+        return false;
+    }
+
+    std::size_t bidCount = orderbook.GetTopLevels(Side::Buy, bids_.data(), depth_);
+    std::size_t askCount = orderbook.GetTopLevels(Side::Sell, asks_.data(), depth_);
+
+    frame_.clear();
+    if (!started_) {
+        // Clear the screen and confine scrolling to the rows below the pane
+        frame_ += "\033[2J\033[";
+        AppendNumber(frame_, PaneRows() + 1);
+        frame_ += ';';
+        AppendNumber(frame_, terminalRows_);
+        frame_ += 'r';
+    } else {
+        frame_ += "\0337";     // Save the console's cursor
+    }
+
+    bool redraw = force || !started_;
+    std::size_t changed {};
+    for (std::size_t index = 0; index < rows_.size(); index++) {
+        ComposeRow(index, bidCount, askCount);
+        if (!redraw && row_ == rows_[index])
+            continue;
+
+        AppendCursor(frame_, index + 1);
+        frame_ += "\033[2K";
+        frame_ += row_;
+        rows_[index].assign(row_);
+        changed++;
+    }
+
+    if (!started_) {
+        AppendCursor(frame_, terminalRows_);
+    } else {
+        frame_ += "\0338";
+    }
+
+    if (changed != 0)
+        Write();
+    started_ = true;
+    pending_ = false;
+    lastFrame_ = now;
+    return true;
+}
+
+void DepthRenderer::RenderPending(const Orderbook& orderbook) {
+    if (!pending_)
+        return;
+
+    // Never waits out the interval, the book's thread must not stall on the pane
+    Render(orderbook);
+}
+
+void DepthRenderer::ComposeRow(std::size_t index, std::size_t bidCount, std::size_t askCount) {
+    row_.clear();
+
+    // Header, asks from the worst shown down to the best, spread, bids from the best, footer
+    if (index == 0) {
+        row_ += "======== Orderbook ========";
+    } else if (index <= depth_) {
+        std::size_t level = depth_ - index;
+        if (level < askCount) {
+            ComposeLevel(asks_[level], Red);
+        } else if (level == 0) {
+            row_ += "          ";
+            row_ += Red;
+            row_ += "No Asks";
+            row_ += Reset;
+        }
+    } else if (index == depth_ + 1) {
+        if (bidCount != 0 && askCount != 0) {
+            row_ += Yellow;
+            row_ += "------- Spread: ";
+            AppendNumber(row_, static_cast<std::int64_t>(asks_[0].price_) - bids_[0].price_);
+            row_ += " -------";
+            row_ += Reset;
+        }
+    } else if (index < PaneRows() - 1) {
+        std::size_t level = index - depth_ - 2;
+        if (level < bidCount) {
+            ComposeLevel(bids_[level], Green);
+        } else if (level == 0) {
+            row_ += "          ";
+            row_ += Green;
+            row_ += "No Bids";
+            row_ += Reset;
+        }
+    } else {
+        row_ += "===========================";
+    }
+}
+
+void DepthRenderer::ComposeLevel(const LevelInfo& level, const char* color) {
+    row_ += "        ";
+    row_ += color;
+    row_ += '$';
+    AppendNumber(row_, level.price_, 6);
+    AppendNumber(row_, level.quantity_, 8);
+    row_ += Reset;
+    row_ += ' ';
+
+    auto blocks = static_cast<std::size_t>(std::max<Quantity>(level.quantity_, 0) / 10);
+    for (std::size_t i = 0; i < std::min(blocks, BarWidth); i++)
+        row_ += Block;
+    if (blocks > BarWidth)
+        row_ += '+';
+}
+
+void DepthRenderer::Write() {
+    std::size_t written {};
+
+    while (written < frame_.size()) {
+        ssize_t bytes = write(outputFd_, frame_.data() + written, frame_.size() - written);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::format("Writing the depth pane failed: {}", std::strerror(errno)));
+        }
+        written += static_cast<std::size_t>(bytes);
+    }
+}
\ No newline at end of file
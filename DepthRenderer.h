@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include "OrderBook.h"
+
+/*
+Depth pane of the interactive console
+
+Shows the best levels of each side in a fixed region at the top of the terminal while the
+console scrolls below it. Levels come from the quantities the book maintains per level, no
+queue is walked and nothing is allocated per frame. A frame holds only the rows that changed
+since the previous one, each rewritten in place through cursor addressing, and goes out in a
+single write. Frames closer together than the refresh interval are skipped unless forced,
+a skipped frame stays pending until RenderPending draws it.
+*/
+class DepthRenderer {
+public:
+    static constexpr std::size_t DefaultDepth = 10;
+    static constexpr std::chrono::milliseconds DefaultInterval {50};
+
+    explicit DepthRenderer(int outputFd, std::size_t depth = DefaultDepth, std::chrono::milliseconds interval = DefaultInterval);
+    DepthRenderer(const DepthRenderer&) = delete;       // Copy constructor
+    void operator=(const DepthRenderer&) = delete;      // Copy assignment
+    DepthRenderer(DepthRenderer&&) = delete;            // Move constructor
+    void operator=(DepthRenderer&&) = delete;           // Move assignment
+    ~DepthRenderer();                                   // Hands the whole terminal back to the console
+
+    // Returns whether a frame was drawn, a forced frame redraws every row
+    bool Render(const Orderbook& orderbook, bool force = false);
+    // Draws a skipped frame if the interval has passed, otherwise it stays pending, never sleeps
+    void RenderPending(const Orderbook& orderbook);
+
+private:
+    static constexpr std::size_t BarWidth = 40;         // Widest quantity bar, one block per 10 units
+    static constexpr std::size_t RowBytes = 64 + BarWidth * 3;
+    static constexpr std::size_t ConsoleRows = 4;       // Kept below the pane at the least
+
+    int outputFd_;
+    std::size_t depth_;
+    std::chrono::milliseconds interval_;
+    std::chrono::steady_clock::time_point lastFrame_;
+    std::size_t terminalRows_;
+    bool started_ {false};
+    bool pending_ {false};              // A frame was skipped, the pane may be stale
+
+    LevelInfos bids_;                   // Best levels of the current frame, sized to depth_ once
+    LevelInfos asks_;
+    std::vector<std::string> rows_;     // What the pane shows, header, asks, spread, bids and footer
+    std::string row_;                   // Row being composed
+    std::string frame_;                 // Escape sequences and changed rows of one frame
+
+    std::size_t PaneRows() const { return 2 * depth_ + 3; }
+    void ComposeRow(std::size_t index, std::size_t bidCount, std::size_t askCount);
+    void ComposeLevel(const LevelInfo& level, const char* color);
+    void Write();
+};
\ No newline at end of file
@@ -67,26 +67,65 @@ OrderId InputHandler::TryParseOrderId(const std::string_view& str) const {
     return static_cast<OrderId>(ToNumber(str));
 }
 
+OwnerId InputHandler::TryParseOwnerId(const std::string_view& str) const {
+    if (str.empty())
+        throw std::logic_error("Invalid ownerid");
+
+    return static_cast<OwnerId>(ToNumber(str));
+}
+
 bool InputHandler::TryParseInfo(const std::string_view& str, Info& info) const {
     auto value = str.at(0);
     auto values = Split(str, ' ');
     
+    // Fields are only read once their count is known, a truncated line is rejected and never read past
+    auto Expect = [&](std::size_t minimum, std::size_t maximum) {
+        if (values.size() < minimum || values.size() > maximum)
+            throw std::logic_error("Invalid input");
+    };
+
     if (value == 'A') {
+        Expect(6, 8);
         info.action_ = ActionType::Add;
         info.side_ = TryParseSide(values[1]);
         info.orderType_ = TryParseOrderType(values[2]);
         info.price_ = TryParsePrice(values[3]);
         info.quantity_ = TryParseQuantity(values[4]);
         info.orderId_ = TryParseOrderId(values[5]);
+        if (values.size() > 6)
+            info.ownerId_ = TryParseOwnerId(values[6]);
+        if (values.size() > 7)
+            info.displayQuantity_ = TryParseQuantity(values[7]);
     } else if (value == 'M') {
+        Expect(5, 5);
         info.action_ = ActionType::Modify;
         info.orderId_ = TryParseOrderId(values[1]);
         info.side_ = TryParseSide(values[2]);
         info.price_ = TryParsePrice(values[3]);
         info.quantity_ = TryParseQuantity(values[4]);
     } else if (value == 'C') {
+        Expect(2, 2);
         info.action_ = ActionType::Cancel;
         info.orderId_ = TryParseOrderId(values[1]);
+    } else if (value == 'X') {
+        info.action_ = ActionType::MassCancel;
+        // Every scope has an exact field count, a truncated range must not widen to the whole side
+        if (values.size() == 1 || (values.size() == 2 && values[1] == "*")) {
+            info.scope_ = CancelScope::All;
+        } else if (values.size() == 3 && values[1] == "O") {
+            info.scope_ = CancelScope::Owner;
+            info.ownerId_ = TryParseOwnerId(values[2]);
+        } else if (values.size() == 2) {
+            info.scope_ = CancelScope::Side;
+            info.side_ = TryParseSide(values[1]);
+        } else if (values.size() == 4) {
+            info.scope_ = CancelScope::PriceRange;
+            info.side_ = TryParseSide(values[1]);
+            info.price_ = TryParsePrice(values[2]);
+            info.maxPrice_ = TryParsePrice(values[3]);
+        } else {
+            throw std::logic_error("Invalid input");
+        }
     } else {
         return false;
     }
@@ -135,18 +174,58 @@ void InputHandler::ReadFromInput(Orderbook& orderbook) const {
     }
 }
 
-void InputHandler::ProcessInfo(const Infos& infos, Orderbook& orderbook) const {
-    for (const auto& info : infos) {
-        switch (info.action_) {
-            case ActionType::Add:
-                orderbook.AddOrder(std::make_shared<Order>(info.orderType_, info.orderId_, info.side_, info.price_, info.quantity_));
-                break;
-            case ActionType::Modify:
-                orderbook.ModifyOrder(OrderModify(info.orderId_, info.side_, info.price_, info.quantity_));
-                break;
-            case ActionType::Cancel:
-                orderbook.CancelOrder(info.orderId_);
-                break;
+std::size_t InputHandler::ReadFromStream(std::istream& stream, Orderbook& orderbook, const ProcessedCallback& onProcessed) const {
+    std::size_t processed {};
+    std::string line;
+
+    // Parse and apply one command at a time so memory stays flat for arbitrarily long captures
+    while (std::getline(stream, line)) {
+        if (line.empty())
+            break;
+
+        Info info;
+
+        if (!TryParseInfo(line, info)) {
+            std::cerr << line << std::endl;
+            throw std::logic_error("Invalid input");
         }
+
+        onProcessed(info, ProcessInfo(info, orderbook));
+        processed++;
+    }
+    return processed;
+}
+
+void InputHandler::ProcessInfo(const Infos& infos, Orderbook& orderbook) const {
+    for (const auto& info : infos)
+        ProcessInfo(info, orderbook);
+}
+
+Trades InputHandler::ProcessInfo(const Info& info, Orderbook& orderbook) const {
+    switch (info.action_) {
+        case ActionType::Add:
+            return orderbook.AddOrder(Order{info.orderType_, info.orderId_, info.side_, info.price_, info.quantity_, info.ownerId_, info.displayQuantity_});
+        case ActionType::Modify:
+            return orderbook.ModifyOrder(OrderModify(info.orderId_, info.side_, info.price_, info.quantity_));
+        case ActionType::Cancel:
+            orderbook.CancelOrder(info.orderId_);
+            break;
+        case ActionType::MassCancel:
+            switch (info.scope_) {
+                case CancelScope::All:
+                    orderbook.MassCancel();
+                    break;
+                case CancelScope::Side:
+                    orderbook.MassCancel(info.side_);
+                    break;
+                case CancelScope::PriceRange:
+                    orderbook.MassCancel(info.side_, info.price_, info.maxPrice_);
+                    break;
+                case CancelScope::Owner:
+                    orderbook.MassCancel(info.ownerId_);
+                    break;
+            }
+            break;
     }
+    return {};
 }
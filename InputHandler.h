@@ -6,20 +6,35 @@
 #include <string>
 #include <vector>
 #include <charconv>
+#include <functional>
 #include "OrderBook.h"
 
 /* 
 Input file format
 
 A B GoodUntilCancel 100 50 1        // Add Side OrderType Price Quantity OrderId
+A B GoodUntilCancel 100 50 1 7      // Add Side OrderType Price Quantity OrderId OwnerId
+A B GoodUntilCancel 100 500 1 0 20  // Add Side OrderType Price Quantity OrderId OwnerId DisplayQuantity, iceberg
 C 1                                 // Cancel OrderId
 M 1 S 100 10                        // Modify OrderId Side Price Quantity 
+X *                                 // Mass cancel everything
+X B                                 // Mass cancel Side
+X B 95 99                           // Mass cancel Side MinPrice MaxPrice
+X O 7                               // Mass cancel OwnerId
 */
 
 enum class ActionType {
     Add,
     Modify,
-    Cancel
+    Cancel,
+    MassCancel
+};
+
+enum class CancelScope {
+    All,
+    Side,
+    PriceRange,
+    Owner
 };
 
 struct Info {
@@ -29,6 +44,10 @@ struct Info {
     Price price_;
     Quantity quantity_;
     OrderId orderId_;
+    OwnerId ownerId_ {Constants::NoOwner};
+    Quantity displayQuantity_ {};   // Iceberg tranche, 0 shows the whole order
+    CancelScope scope_ {CancelScope::All};
+    Price maxPrice_ {};     // Upper bound of a PriceRange mass cancel, price_ is the lower bound
 };
 
 using Infos = std::vector<Info>;
@@ -43,11 +62,17 @@ private:
     Price TryParsePrice(const std::string_view& str) const;
     Quantity TryParseQuantity(const std::string_view& str) const;
     OrderId TryParseOrderId(const std::string_view& str) const;
-    bool TryParseInfo(const std::string_view& str, Info& info) const;
+    OwnerId TryParseOwnerId(const std::string_view& str) const;
 
 public: 
+    bool TryParseInfo(const std::string_view& str, Info& info) const;
+
+    using ProcessedCallback = std::function<void(const Info&, const Trades&)>;
+
     void ReadFromFile(const std::filesystem::path& path, Orderbook& orderbook) const;
     void ReadFromInput(Orderbook& orderbook) const;
+    std::size_t ReadFromStream(std::istream& stream, Orderbook& orderbook, const ProcessedCallback& onProcessed) const;
     void ProcessInfo(const Infos& infos, Orderbook& orderbook) const;
+    Trades ProcessInfo(const Info& info, Orderbook& orderbook) const;
 };
 
@@ -1,5 +1,8 @@
 #include "Interface.h"
 
+#include <unistd.h>
+#include "DepthRenderer.h"
+
 bool Interface::isNumeric(const std::string& str) const {
     for (char c : str) {
         if (!std::isdigit(c))
@@ -111,7 +114,7 @@ OrderId Interface::SelectOrderId() const {
 
 void Interface::PrintMenu() const {
     std::cout << "---------------------\n";
-    std::cout << "P. Print Order Book\n";
+    std::cout << "P. Redraw Order Book\n";
     std::cout << "A. Add Order\n";
     std::cout << "M. Modify Order\n";
     std::cout << "C. Cancel Order\n";
@@ -152,30 +155,44 @@ void Interface::PressCancelOrder(Orderbook& orderbook, InputHandler& handler) co
 }
 
 void Interface::Run(Orderbook& orderbook, InputHandler& handler) const {
+    DepthRenderer renderer {STDOUT_FILENO};
+    renderer.Render(orderbook, true);
+
+    // The pane is written past std::cout, whatever the console printed must be out first
+    auto Render = [&](bool force) {
+        std::cout.flush();
+        renderer.Render(orderbook, force);
+    };
+
     char choice;
     PrintMenu();
     do {
+        // Catch up on a frame skipped by the throttle whose interval has passed by now
+        std::cout.flush();
+        renderer.RenderPending(orderbook);
+
         std::cout << "Enter choice: ";
         std::cin >> choice;
         choice = std::toupper(choice);
         
         switch (choice) {
             case 'P': {
-                orderbook.PrintOrderbook();
+                Render(true);
                 break;
             }
             case 'A': {
                 PressAddOrder(orderbook, handler);
-                orderbook.PrintOrderbook();
+                Render(false);
                 break;
             }
             case 'M': {
                 PressModifyOrder(orderbook, handler);
-                orderbook.PrintOrderbook();
+                Render(false);
                 break;
             }
             case 'C': {
                 PressCancelOrder(orderbook, handler);
+                Render(false);
                 break;
             }
             case 'Q': {
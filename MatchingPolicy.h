@@ -0,0 +1,27 @@
+#pragma once
+
+/*
+Allocation rules for an incoming order crossing a level, chosen at compile time
+
+FifoPolicy fills the resting orders in time priority, front to front, and is what Orderbook uses.
+The pro-rata policies split the incoming quantity over the whole level in proportion to the shown
+quantity of every resting order. Shares are rounded down and the lots lost to rounding go one per
+order in time priority, so the same book and order always allocate the same way.
+TopOrderProRataPolicy first fills the order at the front of the level, the rest of the incoming
+quantity is split pro-rata over the other orders.
+*/
+
+struct FifoPolicy {
+    static constexpr bool ProRata = false;
+    static constexpr bool TopOrder = false;
+};
+
+struct ProRataPolicy {
+    static constexpr bool ProRata = true;
+    static constexpr bool TopOrder = false;
+};
+
+struct TopOrderProRataPolicy {
+    static constexpr bool ProRata = true;
+    static constexpr bool TopOrder = true;     // Front order filled in full before the split
+};
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "MemoryArena.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <linux/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#endif
+
+HugePageArena::HugePageArena(std::size_t capacity, int numaNode, std::pmr::memory_resource* upstream)
+    : upstream_ {upstream}
+{
+    capacity_ = (capacity + HugePageSize - 1) / HugePageSize * HugePageSize;
+    if (capacity_ == 0)
+        return;
+
+#ifdef __linux__
+    // Explicit huge pages, only available if the administrator reserved them
+    void* memory = mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_HUGE_2MB, -1, 0);
+
+    if (memory != MAP_FAILED) {
+        base_ = static_cast<std::byte*>(memory);
+        stats_.hugePages_ = true;
+    } else {
+        // Fall back to regular pages aligned on a huge page boundary so THP can back the whole range
+        std::size_t length = capacity_ + HugePageSize;
+        memory = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+            throw std::bad_alloc();
+
+        auto address = reinterpret_cast<std::uintptr_t>(memory);
+        auto aligned = (address + HugePageSize - 1) / HugePageSize * HugePageSize;
+        if (aligned != address)
+            munmap(memory, aligned - address);
+        if (auto tail = (address + length) - (aligned + capacity_); tail != 0)
+            munmap(reinterpret_cast<void*>(aligned + capacity_), tail);
+
+        base_ = reinterpret_cast<std::byte*>(aligned);
+        madvise(base_, capacity_, MADV_HUGEPAGE);
+    }
+
+    // Bind before the first touch so every page is placed on the matching thread's node
+    if (numaNode >= 0) {
+        unsigned long nodeMask = 1UL << numaNode;
+        if (syscall(SYS_mbind, base_, capacity_, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8, 0) == 0)
+            stats_.numaNode_ = numaNode;
+    }
+
+    std::memset(base_, 0, capacity_);
+#else
+    base_ = static_cast<std::byte*>(upstream_->allocate(capacity_, HugePageSize));
+#endif
+
+    stats_.reserved_ = capacity_;
+}
+
+HugePageArena::~HugePageArena() {
+    if (base_ == nullptr)
+        return;
+
+#ifdef __linux__
+    munmap(base_, capacity_);
+#else
+    upstream_->deallocate(base_, capacity_, HugePageSize);
+#endif
+}
+
+int HugePageArena::CurrentNumaNode() {
+#ifdef __linux__
+    unsigned cpu {}, node {};
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        return static_cast<int>(node);
+#endif
+    return -1;
+}
+
+std::size_t HugePageArena::ClassIndex(std::size_t bytes) {
+    if (bytes <= SmallClassLimit)
+        return (bytes + SmallClassGranularity - 1) / SmallClassGranularity - 1;
+
+    // Power of two classes above the small classes, starting at 512 bytes
+    return SmallClassCount + std::bit_width(bytes - 1) - std::bit_width(SmallClassLimit);
+}
+
+std::size_t HugePageArena::ClassSize(std::size_t index) {
+    if (index < SmallClassCount)
+        return (index + 1) * SmallClassGranularity;
+
+    return SmallClassLimit << (index - SmallClassCount + 1);
+}
+
+std::size_t HugePageArena::AlignmentIndex(std::size_t alignment) {
+    // Everything up to the default alignment shares the first lists
+    return std::bit_width(std::max(alignment, alignof(std::max_align_t)) / alignof(std::max_align_t)) - 1;
+}
+
+bool HugePageArena::Owns(const void* pointer) const {
+    auto address = static_cast<const std::byte*>(pointer);
+    return address >= base_ && address < base_ + capacity_;
+}
+
+void* HugePageArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    std::size_t index = ClassIndex(std::max(bytes, std::size_t{1}));
+    std::size_t size = ClassSize(index);
+    void* pointer = nullptr;
+
+    // A free list only holds blocks carved at its own alignment
+    if (index < ClassCount && alignment <= MaxAlignment) {
+        FreeBlock*& freeList = freeLists_[AlignmentIndex(alignment)][index];
+        if (freeList != nullptr) {
+            pointer = freeList;
+            freeList = freeList->next_;
+        } else {
+            std::size_t start = (offset_ + alignment - 1) / alignment * alignment;
+            if (start + size <= capacity_) {
+                pointer = base_ + start;
+                offset_ = start + size;
+                stats_.footprint_ = offset_;
+            }
+        }
+    }
+
+    if (pointer == nullptr) {
+        pointer = upstream_->allocate(bytes, alignment);
+        stats_.upstream_ += bytes;
+        size = bytes;
+    }
+
+    stats_.inUse_ += size;
+    stats_.highWater_ = std::max(stats_.highWater_, stats_.inUse_);
+    return pointer;
+}
+
+void HugePageArena::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+    if (!Owns(pointer)) {
+        upstream_->deallocate(pointer, bytes, alignment);
+        stats_.upstream_ -= bytes;
+        stats_.inUse_ -= bytes;
+        return;
+    }
+
+    std::size_t index = ClassIndex(std::max(bytes, std::size_t{1}));
+    stats_.inUse_ -= ClassSize(index);
+
+    FreeBlock*& freeList = freeLists_[AlignmentIndex(alignment)][index];
+    auto block = static_cast<FreeBlock*>(pointer);
+    block->next_ = freeList;
+    freeList = block;
+}
+
+bool HugePageArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
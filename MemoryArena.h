@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory_resource>
+
+/*
+Arena backing all memory of an Orderbook
+
+The whole capacity is reserved up front, preferably from 2MB huge pages (MAP_HUGETLB),
+otherwise from regular pages with transparent huge pages requested through madvise.
+The range is bound to the NUMA node of the constructing thread (or an explicit node)
+and prefaulted, so the matching thread never takes a page fault on the hot path.
+
+Blocks are carved with a bump pointer and recycled through size class free lists, kept
+apart per alignment so an over-aligned block is only handed out again at its alignment.
+Requests that do not fit anymore, or need more than page alignment, fall through to the
+upstream resource.
+Not thread safe, meant to be owned by the matching thread.
+*/
+
+struct ArenaStats {
+    std::size_t reserved_{};    // Bytes mapped up front
+    std::size_t footprint_{};   // Bytes carved from the arena so far
+    std::size_t inUse_{};       // Bytes currently handed out (arena and upstream)
+    std::size_t highWater_{};   // Maximum of inUse_ over the arena lifetime
+    std::size_t upstream_{};    // Bytes currently handed out by the upstream resource
+    bool hugePages_{};          // Backed by explicit 2MB huge pages
+    int numaNode_{-1};          // Node the range is bound to, -1 if unbound
+};
+
+class HugePageArena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t HugePageSize = 2 * 1024 * 1024;
+
+    explicit HugePageArena(std::size_t capacity,
+                           int numaNode = CurrentNumaNode(),
+                           std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+    HugePageArena(const HugePageArena&) = delete;       // Copy constructor
+    void operator=(const HugePageArena&) = delete;      // Copy assignment
+    HugePageArena(HugePageArena&&) = delete;            // Move constructor
+    void operator=(HugePageArena&&) = delete;           // Move assignment
+    ~HugePageArena() override;                          // Destructor
+
+    const ArenaStats& GetStats() const { return stats_; }
+    static int CurrentNumaNode();
+
+private:
+    static constexpr std::size_t SmallClassGranularity = 16;
+    static constexpr std::size_t SmallClassLimit = 256;
+    static constexpr std::size_t SmallClassCount = SmallClassLimit / SmallClassGranularity;
+    static constexpr std::size_t LargeClassCount = 48;
+    static constexpr std::size_t ClassCount = SmallClassCount + LargeClassCount;
+    static constexpr std::size_t MaxAlignment = 4096;
+    static constexpr std::size_t AlignmentCount = std::bit_width(MaxAlignment / alignof(std::max_align_t));
+
+    struct FreeBlock {
+        FreeBlock* next_;
+    };
+
+    std::byte* base_ {nullptr};
+    std::size_t capacity_ {};
+    std::size_t offset_ {};
+    std::pmr::memory_resource* upstream_;
+    std::array<std::array<FreeBlock*, ClassCount>, AlignmentCount> freeLists_ {};     // By alignment, then size class
+    ArenaStats stats_;
+
+    static std::size_t ClassIndex(std::size_t bytes);
+    static std::size_t ClassSize(std::size_t index);
+    static std::size_t AlignmentIndex(std::size_t alignment);
+    bool Owns(const void* pointer) const;
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
@@ -1,34 +1,45 @@
 #pragma once
 
-#include <list>
 #include <format>
 #include <iostream>
 #include "Datatypes.h"
 #include "OrderType.h"
 
-class Order {
+template <typename Traits>
+class BasicOrder {
 public: 
-    Order(OrderType orderType, OrderId orderId, Side side, Price price, Quantity quantity)
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
+    BasicOrder(OrderType orderType, OrderId orderId, Side side, Price price, Quantity quantity, OwnerId ownerId = Constants::NoOwner, Quantity displayQuantity = 0)
         : orderType_ {orderType}, 
           orderId_ {orderId}, 
           side_ {side}, 
-          price_ {price}, 
+          price_ {Traits::NormalizePrice(side, price)}, 
           initialQuantity_ {quantity},
-          remainingQuantity_ {quantity}
-    { }
+          remainingQuantity_ {quantity},
+          ownerId_ {ownerId},
+          displayQuantity_ {displayQuantity}
+    {
+        if (displayQuantity_ < 0 || (displayQuantity_ != 0 && orderType_ != OrderType::GoodUntilCancel))
+            throw std::logic_error(std::format("Order ({}) only GoodUntilCancel orders can show a display quantity", GetOrderId()));
+    }
 
-    Order(OrderId orderId, Side side, Quantity quantity)
-        : Order(OrderType::Market, orderId, side, Constants::InvalidPrice, quantity)
+    BasicOrder(OrderId orderId, Side side, Quantity quantity)
+        : BasicOrder(OrderType::Market, orderId, side, Traits::InvalidPrice, quantity)
     { }
     
     OrderId GetOrderId() const { return orderId_; }
     Side GetSide() const { return side_; }
     Price GetPrice() const { return price_; }
     OrderType GetOrderType() const { return orderType_; }
+    OwnerId GetOwnerId() const { return ownerId_; }
     Quantity GetInitialQuantity() const { return initialQuantity_; }
     Quantity GetRemainingQuantity() const { return remainingQuantity_; }
     Quantity GetFilledQuantity() const { return initialQuantity_ - remainingQuantity_; }
+    Quantity GetDisplayQuantity() const { return displayQuantity_; }
 
+    bool IsIceberg() const { return displayQuantity_ != 0 && displayQuantity_ < initialQuantity_; }
     bool IsFilled() const { return GetRemainingQuantity() == 0; }
 
     void Fill(Quantity quantity) {
@@ -54,8 +65,8 @@ private:
     Price price_;
     Quantity initialQuantity_;
     Quantity remainingQuantity_;
+    OwnerId ownerId_;
+    Quantity displayQuantity_;      // Tranche shown by an iceberg, 0 shows the whole order
 };
 
-// Reference semantics
-using OrderPointer = std::shared_ptr<Order>;    // Order can be stored in both orders dict and bid/ask dict
-using OrderPointers = std::list<OrderPointer>;  // List of order pointers
\ No newline at end of file
+using Order = BasicOrder<DefaultTraits>;
\ No newline at end of file
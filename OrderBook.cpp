@@ -1,8 +1,80 @@
 #include "OrderBook.h"
+#include <chrono>
+#include <experimental/simd>
 #include "OrderType.h"
 #include "Order.h"
 
-bool Orderbook::CanMatch(Side side, Price price) const {
+namespace stdx = std::experimental;
+
+namespace {
+    constexpr std::size_t AllocationLanes = 8;
+    using VolumeLanes = stdx::fixed_size_simd<std::int64_t, AllocationLanes>;
+    using WrappingLanes = stdx::fixed_size_simd<std::uint64_t, AllocationLanes>;
+    using RatioLanes = stdx::fixed_size_simd<double, AllocationLanes>;
+
+    // Pro-rata shares of incoming over the resting quantities, rounded down in one vector pass.
+    // The lots lost to rounding go one per order in time priority. A share is estimated in
+    // floating point and corrected to the exact floor by the sign of quantity * incoming -
+    // share * total, computed in unsigned lanes: the products may wrap but the difference is
+    // small, so two's complement makes it exact. Exact for quantities below 2^53.
+    template <typename Quantity>
+    void AllocateProRata(const Quantity* resting, Quantity* fills, std::size_t count, Quantity total, Quantity incoming) {
+        incoming = std::min(incoming, total);
+        if (count == 0 || incoming <= 0) {
+            std::fill_n(fills, count, Quantity {});
+            return;
+        }
+
+        double ratio = static_cast<double>(incoming) / static_cast<double>(total);
+        auto Share = [&](std::int64_t quantity) {
+            auto share = static_cast<std::int64_t>(std::floor(static_cast<double>(quantity) * ratio));
+            auto rest = static_cast<std::int64_t>(static_cast<std::uint64_t>(quantity) * incoming - static_cast<std::uint64_t>(share) * total);
+            return static_cast<Quantity>(share + (rest >= total) - (rest < 0));
+        };
+
+        VolumeLanes allocated(0);
+        std::size_t row = 0;
+        for (; row + AllocationLanes <= count; row += AllocationLanes) {
+            VolumeLanes quantities(resting + row, stdx::element_aligned);
+            auto shares = stdx::static_simd_cast<VolumeLanes>(stdx::floor(stdx::static_simd_cast<RatioLanes>(quantities) * RatioLanes(ratio)));
+            auto rest = stdx::static_simd_cast<VolumeLanes>(stdx::static_simd_cast<WrappingLanes>(quantities) * static_cast<std::uint64_t>(incoming)
+                - stdx::static_simd_cast<WrappingLanes>(shares) * static_cast<std::uint64_t>(total));
+            stdx::where(rest >= static_cast<std::int64_t>(total), shares) += 1;
+            stdx::where(rest < 0, shares) -= 1;
+            stdx::static_simd_cast<stdx::fixed_size_simd<Quantity, AllocationLanes>>(shares).copy_to(fills + row, stdx::element_aligned);
+            allocated += shares;
+        }
+
+        auto left = static_cast<std::int64_t>(incoming) - stdx::reduce(allocated);
+        for (; row < count; row++) {
+            fills[row] = Share(resting[row]);
+            left -= fills[row];
+        }
+
+        for (std::size_t i = 0; left > 0; i = (i + 1) % count) {
+            if (fills[i] < resting[i]) {
+                fills[i]++;
+                left--;
+            }
+        }
+    }
+}
+
+template <typename Traits, typename Policy>
+BasicOrderbook<Traits, Policy>::BasicOrderbook(std::pmr::memory_resource* resource)
+    : resource_ {resource},
+      bids_ {resource},
+      asks_ {resource},
+      orders_ {resource},
+      data_ {resource},
+      owners_ {resource},
+      allocationSlots_ {resource},
+      allocationQuantities_ {resource},
+      allocationFills_ {resource}
+{ }
+
+template <typename Traits, typename Policy>
+bool BasicOrderbook<Traits, Policy>::CanMatch(Side side, Price price) const {
     if (side == Side::Buy) {
         return !asks_.empty() && asks_.begin()->first <= price;
     } else {
@@ -10,7 +82,8 @@ bool Orderbook::CanMatch(Side side, Price price) const {
     }
 }
 
-bool Orderbook::CanFullyFill(Side side, Price price, Quantity quantity) const {
+template <typename Traits, typename Policy>
+bool BasicOrderbook<Traits, Policy>::CanFullyFill(Side side, Price price, Quantity quantity) const {
 	if (!CanMatch(side, price))
 		return false;
 
@@ -39,9 +112,14 @@ bool Orderbook::CanFullyFill(Side side, Price price, Quantity quantity) const {
 	return false;
 }
 
-void Orderbook::UpdateLevelData(Price price, Quantity quantity, LevelData::Action action) {
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::UpdateLevelData(Price price, Quantity quantity, LevelData::Action action) {
 	auto& data = data_[price];
 
+    // A price can only sit in the window of one side, marking both stays correct and branch free
+    bidWindow_.dirty_ |= price >= bidWindow_.edge_;
+    askWindow_.dirty_ |= price <= askWindow_.edge_;
+
     // Update order count
 	data.count_ += action == LevelData::Action::Remove ? -1 : action == LevelData::Action::Add ? 1 : 0;
 
@@ -57,9 +135,145 @@ void Orderbook::UpdateLevelData(Price price, Quantity quantity, LevelData::Actio
 		data_.erase(price);
 }
 
-Trades Orderbook::MatchOrders() {
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::EraseLevel(Side side, Price price) {
+    if (side == Side::Buy) {
+        bids_.erase(price);
+    } else {
+        asks_.erase(price);
+    }
+    data_.erase(price);
+}
+
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::UnlinkOwner(const OrderDetails& details) {
+    if (details.ownerId_ == Constants::NoOwner)
+        return;
+
+    auto owner = owners_.find(details.ownerId_);
+    owner->second.erase(details.ownerLocation_);
+    if (owner->second.empty())
+        owners_.erase(owner);
+}
+
+template <typename Traits, typename Policy>
+bool BasicOrderbook<Traits, Policy>::Refill(OrderQueue& level, Slot slot) {
+    auto& details = level.GetDetails(slot);
+    if (details.reserveQuantity_ == 0)
+        return false;
+
+    // Same node and slot, only its place in the queue changes
+    Quantity tranche = std::min(details.displayQuantity_, details.reserveQuantity_);
+    details.reserveQuantity_ -= tranche;
+    level.GetNode(slot).remainingQuantity_ = tranche;
+    level.MoveToBack(slot);
+
+    UpdateLevelData(level.GetPrice(), tranche, LevelData::Action::Refill);
+    return true;
+}
+
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::EraseOrder(OrderId orderId, const OrderDetails& details) {
+    UnlinkOwner(details);
+    orders_.erase(orderId);
+}
+
+template <typename Traits, typename Policy>
+template <typename Levels>
+void BasicOrderbook<Traits, Policy>::CancelLevels(Levels& levels, typename Levels::iterator first, typename Levels::iterator last, OrderIds& cancelled) {
+    for (auto level = first; level != last; ++level) {
+        auto& [price, orders] = *level;
+
+        for (Slot slot = orders.Front(); slot != OrderQueue::NoSlot; slot = orders.Next(slot)) {
+            const auto& node = orders.GetNode(slot);
+            cancelled.push_back(node.orderId_);
+            EraseOrder(node.orderId_, orders.GetDetails(slot));
+        }
+        data_.erase(price);
+    }
+    levels.erase(first, last);
+    bidWindow_.dirty_ = askWindow_.dirty_ = true;
+}
+
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::MatchLevel(OrderQueue& incoming, OrderQueue& resting, Trades& trades) {
+    Price incomingPrice = incoming.GetPrice();
+    Price restingPrice = resting.GetPrice();
+
+    auto MakeTrade = [&](OrderId incomingId, OrderId restingId, Quantity quantity) {
+        TradeInfo incomingTrade {incomingId, incomingPrice, quantity};
+        TradeInfo restingTrade {restingId, restingPrice, quantity};
+        return incoming.GetSide() == Side::Buy ? Trade{incomingTrade, restingTrade} : Trade{restingTrade, incomingTrade};
+    };
+
+    while (!incoming.Empty()) {
+        // Collect the orders of the level in time priority
+        allocationSlots_.clear();
+        allocationQuantities_.clear();
+        Quantity total {};
+        for (Slot slot = resting.Front(); slot != OrderQueue::NoSlot; slot = resting.Next(slot)) {
+            const auto& node = resting.GetNode(slot);
+            allocationSlots_.push_back(slot);
+            allocationQuantities_.push_back(node.remainingQuantity_);
+            total += node.remainingQuantity_;
+        }
+        if (allocationSlots_.empty())
+            break;
+
+        Slot incomingSlot = incoming.Front();
+        auto& order = incoming.GetNode(incomingSlot);
+        std::size_t count = allocationSlots_.size();
+        allocationFills_.resize(count);
+
+        if constexpr (Policy::TopOrder) {
+            allocationFills_[0] = std::min(allocationQuantities_[0], order.remainingQuantity_);
+            AllocateProRata(allocationQuantities_.data() + 1, allocationFills_.data() + 1, count - 1,
+                total - allocationQuantities_[0], order.remainingQuantity_ - allocationFills_[0]);
+        } else {
+            AllocateProRata(allocationQuantities_.data(), allocationFills_.data(), count, total, order.remainingQuantity_);
+        }
+
+        Quantity matched {};
+        for (std::size_t i = 0; i < count; i++) {
+            Quantity quantity = allocationFills_[i];
+            if (quantity == 0)
+                continue;
+
+            Slot slot = allocationSlots_[i];
+            auto& node = resting.GetNode(slot);
+
+            if (verbose_)
+                std::cout << std::format("Matching bid {} with ask {} for quantity {}", std::max(incomingPrice, restingPrice),
+                    std::min(incomingPrice, restingPrice), quantity) << std::endl;
+
+            node.remainingQuantity_ -= quantity;
+            matched += quantity;
+            trades.push_back(MakeTrade(order.orderId_, node.orderId_, quantity));
+
+            bool filled = node.remainingQuantity_ == 0 && !Refill(resting, slot);
+            if (filled) {
+                EraseOrder(node.orderId_, resting.GetDetails(slot));
+                resting.Erase(slot);
+            }
+            UpdateLevelData(restingPrice, quantity, filled ? LevelData::Action::Remove : LevelData::Action::Match);
+        }
+
+        // The whole level was allocated if anything of the shown incoming quantity is left
+        order.remainingQuantity_ -= matched;
+        bool filled = order.remainingQuantity_ == 0 && !Refill(incoming, incomingSlot);
+        if (filled) {
+            EraseOrder(order.orderId_, incoming.GetDetails(incomingSlot));
+            incoming.PopFront();
+        }
+        UpdateLevelData(incomingPrice, matched, filled ? LevelData::Action::Remove : LevelData::Action::Match);
+    }
+}
+
+template <typename Traits, typename Policy>
+auto BasicOrderbook<Traits, Policy>::MatchOrders(Side aggressor) -> Trades {
+    PerfScope scope {recorder_, BookOperation::Match};
+
     Trades trades; 
-    trades.reserve(orders_.size());
     
     while (true) {
         if (bids_.empty() || asks_.empty())
@@ -72,179 +286,360 @@ Trades Orderbook::MatchOrders() {
             break;
         }
 
-        while (!bids.empty() && !asks.empty()) {
-            auto bid = bids.front();
-            auto ask = asks.front();
+        if constexpr (Policy::ProRata) {
+            if (aggressor == Side::Buy) {
+                MatchLevel(bids, asks, trades);
+            } else {
+                MatchLevel(asks, bids, trades);
+            }
+        } else {
+            while (!bids.Empty() && !asks.Empty()) {
+                Slot bidSlot = bids.Front();
+                Slot askSlot = asks.Front();
+                auto& bid = bids.GetNode(bidSlot);
+                auto& ask = asks.GetNode(askSlot);
 
-            Quantity quantity = std::min(bid->GetRemainingQuantity(), ask->GetRemainingQuantity());
+                Quantity quantity = std::min(bid.remainingQuantity_, ask.remainingQuantity_);
 
-            std::cout << std::format("Matching bid {} with ask {} for quantity {}", bid->GetPrice(), ask->GetPrice(), quantity) << std::endl;
+                if (verbose_)
+                    std::cout << std::format("Matching bid {} with ask {} for quantity {}", bidPrice, askPrice, quantity) << std::endl;
 
-            bid->Fill(quantity);
-            ask->Fill(quantity);
+                bid.remainingQuantity_ -= quantity;
+                ask.remainingQuantity_ -= quantity;
 
-            if (bid->IsFilled()) {
-                orders_.erase(bid->GetOrderId());
-                bids.pop_front();
-            }
+                trades.push_back(Trade{
+                    TradeInfo{bid.orderId_, bidPrice, quantity},  // Append bid trade
+                    TradeInfo{ask.orderId_, askPrice, quantity}   // Append ask trade
+                });
 
-            if (ask->IsFilled()) {
-                orders_.erase(ask->GetOrderId());
-                asks.pop_front();
-            }
+                // An iceberg whose tranche is used up shows the next one at the back of the level
+                bool bidFilled = bid.remainingQuantity_ == 0 && !Refill(bids, bidSlot);
+                bool askFilled = ask.remainingQuantity_ == 0 && !Refill(asks, askSlot);
 
-            trades.push_back(Trade{
-                TradeInfo{bid->GetOrderId(), bid->GetPrice(), quantity},  // Append bid trade
-                TradeInfo{ask->GetOrderId(), ask->GetPrice(), quantity}   // Append ask trade
-            });
+                if (bidFilled) {
+                    EraseOrder(bid.orderId_, bids.GetDetails(bidSlot));
+                    bids.PopFront();
+                }
 
-            UpdateLevelData(bid->GetPrice(), quantity, bid->IsFilled() ? LevelData::Action::Remove : LevelData::Action::Match);
-            UpdateLevelData(ask->GetPrice(), quantity, ask->IsFilled() ? LevelData::Action::Remove : LevelData::Action::Match);
+                if (askFilled) {
+                    EraseOrder(ask.orderId_, asks.GetDetails(askSlot));
+                    asks.PopFront();
+                }
+
+                UpdateLevelData(bidPrice, quantity, bidFilled ? LevelData::Action::Remove : LevelData::Action::Match);
+                UpdateLevelData(askPrice, quantity, askFilled ? LevelData::Action::Remove : LevelData::Action::Match);
+            }
         }
 
-        if (bids.empty()) {
+        if (bids.Empty()) {
             bids_.erase(bidPrice);
-            data_.erase(bidPrice);
         }
 
-        if (asks.empty()) {
+        if (asks.Empty()) {
             asks_.erase(askPrice);
-            data_.erase(askPrice);
         }
     }
 
     // Cancel FillAndKill buy orders
     if (!bids_.empty()) {
         auto& [_, bids] = *bids_.begin();
-        auto& order = bids.front();
-        if (order->GetOrderType() == OrderType::FillAndKill) {
-            std::cout << "Cancelling FillAndKill order" << std::endl;
-            CancelOrder(order->GetOrderId());
+        if (bids.GetDetails(bids.Front()).orderType_ == OrderType::FillAndKill) {
+            if (verbose_)
+                std::cout << "Cancelling FillAndKill order" << std::endl;
+            CancelOrder(bids.GetNode(bids.Front()).orderId_);
         }
     }
 
     // Cancel FillAndKill sell orders
     if (!asks_.empty()) {
         auto& [_, asks] = *asks_.begin();
-        auto& order = asks.front();
-        if (order->GetOrderType() == OrderType::FillAndKill) {
-            std::cout << "Cancelling FillAndKill order" << std::endl;
-            CancelOrder(order->GetOrderId());
+        if (asks.GetDetails(asks.Front()).orderType_ == OrderType::FillAndKill) {
+            if (verbose_)
+                std::cout << "Cancelling FillAndKill order" << std::endl;
+            CancelOrder(asks.GetNode(asks.Front()).orderId_);
         }
     }
 
     return trades; 
 }
 
-Trades Orderbook::AddOrder(OrderPointer order) {
-    if (orders_.contains(order->GetOrderId())) {
-        std::cout << std::format("OrderId {} already exists", order->GetOrderId()) << std::endl;
+template <typename Traits, typename Policy>
+auto BasicOrderbook<Traits, Policy>::AddOrder(Order order) -> Trades {
+    PerfScope scope {recorder_, BookOperation::Add};
+
+    if (orders_.contains(order.GetOrderId())) {
+        if (verbose_)
+            std::cout << std::format("OrderId {} already exists", order.GetOrderId()) << std::endl;
         return {};
     }
 
     // Market order is effectively buying/selling avaliable orders until filled
-    if (order->GetOrderType() == OrderType::Market) {
-        if (order->GetSide() == Side::Buy && !asks_.empty()) {
+    if (order.GetOrderType() == OrderType::Market) {
+        if (order.GetSide() == Side::Buy && !asks_.empty()) {
             const auto& [worstAsk, _] = *asks_.rbegin();
-            order->MakeGoodUntilCancel(worstAsk);              // If not filled, place order at worstAsk
-        } else if (order->GetSide() == Side::Sell && !bids_.empty()){
+            order.MakeGoodUntilCancel(worstAsk);              // If not filled, place order at worstAsk
+        } else if (order.GetSide() == Side::Sell && !bids_.empty()){
             const auto& [worstBid, _] = *bids_.rbegin();
-            order->MakeGoodUntilCancel(worstBid);              // If not filled, place order at worstBid
+            order.MakeGoodUntilCancel(worstBid);              // If not filled, place order at worstBid
         } else {
             return {};
         }
     }
 
-    if (order->GetOrderType() == OrderType::FillAndKill && !CanMatch(order->GetSide(), order->GetPrice())) {
-        std::cout << std::format("No match for FillAndKill order {}", order->GetOrderId()) << std::endl;
+    if (order.GetOrderType() == OrderType::FillAndKill && !CanMatch(order.GetSide(), order.GetPrice())) {
+        if (verbose_)
+            std::cout << std::format("No match for FillAndKill order {}", order.GetOrderId()) << std::endl;
         return {};
     }
 
-    if (order->GetOrderType() == OrderType::FillOrKill && !CanFullyFill(order->GetSide(), order->GetPrice(), order->GetInitialQuantity())) {
-        std::cout << std::format("Cannot fully fill FillOrKill order {}", order->GetOrderId()) << std::endl;
+    if (order.GetOrderType() == OrderType::FillOrKill && !CanFullyFill(order.GetSide(), order.GetPrice(), order.GetInitialQuantity())) {
+        if (verbose_)
+            std::cout << std::format("Cannot fully fill FillOrKill order {}", order.GetOrderId()) << std::endl;
         return {};
     }
 
-    OrderPointers::iterator iterator;
-
-    if (order->GetSide() == Side::Buy) {
-        auto& orders = bids_[order->GetPrice()];
-        orders.push_back(order);
-        iterator = std::prev(orders.end());
-    } else {
-        auto& orders = asks_[order->GetPrice()];
-        orders.push_back(order);
-        iterator = std::prev(orders.end());
+    OrderQueue& level = order.GetSide() == Side::Buy
+        ? bids_.try_emplace(order.GetPrice(), Side::Buy, order.GetPrice()).first->second
+        : asks_.try_emplace(order.GetPrice(), Side::Sell, order.GetPrice()).first->second;
+
+    // Only the first tranche of an iceberg is shown, the rest waits in its details
+    Quantity displayed = order.IsIceberg() ? std::min(order.GetDisplayQuantity(), order.GetRemainingQuantity()) : order.GetRemainingQuantity();
+    OrderDetails details {order.GetOrderType(), order.GetInitialQuantity(), order.IsIceberg() ? order.GetDisplayQuantity() : 0,
+        order.GetRemainingQuantity() - displayed, order.GetOwnerId(), {}};
+    if (order.GetOwnerId() != Constants::NoOwner) {
+        auto& owned = owners_[order.GetOwnerId()];
+        details.ownerLocation_ = owned.insert(owned.end(), order.GetOrderId());
     }
 
-    orders_.insert({order->GetOrderId(), OrderEntry{order, iterator}});
-    UpdateLevelData(order->GetPrice(), order->GetInitialQuantity(), LevelData::Action::Add);
+    Slot slot = level.PushBack(order.GetOrderId(), displayed, details);
+    orders_.insert({order.GetOrderId(), OrderEntry{&level, slot}});
+    UpdateLevelData(order.GetPrice(), displayed, LevelData::Action::Add);
+
+    Trades trades = MatchOrders(order.GetSide());
+    if (tradeLog_ != nullptr && !trades.empty()) {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        tradeLog_->Append(trades, order.GetSide(), std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
 
-    return MatchOrders();
+    RefreshSignals();
+    return trades;
 }
 
-void Orderbook::CancelOrder(OrderId orderId) {
-    if (!orders_.contains(orderId)) {
-        std::cout << std::format("OrderId {} does not exist", orderId) << std::endl;
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::CancelOrder(OrderId orderId) {
+    PerfScope scope {recorder_, BookOperation::Cancel};
+
+    auto entry = orders_.find(orderId);
+    if (entry == orders_.end()) {
+        if (verbose_)
+            std::cout << std::format("OrderId {} does not exist", orderId) << std::endl;
         return;
     }
 
-    const auto [order, iterator] = orders_.at(orderId);
-    orders_.erase(orderId);
+    auto [level, slot] = entry->second;
+    auto side = level->GetSide();
+    auto price = level->GetPrice();
+    auto& node = level->GetNode(slot);
 
-    if (order->GetSide() == Side::Sell) {
-        auto price = order->GetPrice();
-        auto& orders = asks_.at(price);
-        orders.erase(iterator);
-        if (orders.empty())
-            asks_.erase(price);
-    } else {
-        auto price = order->GetPrice();
-        auto& orders = bids_.at(price);
-        orders.erase(iterator);
-        if (orders.empty())
-            bids_.erase(price);
-    }
+    UnlinkOwner(level->GetDetails(slot));
+    orders_.erase(entry);
+    UpdateLevelData(price, node.remainingQuantity_, LevelData::Action::Remove);
+    level->Erase(slot);
 
-    UpdateLevelData(order->GetPrice(), order->GetRemainingQuantity(), LevelData::Action::Remove);
+    // No order left, drop the level whole so the best price stays live
+    if (!data_.contains(price))
+        EraseLevel(side, price);
+
+    RefreshSignals();
 }
 
-Trades Orderbook::ModifyOrder(OrderModify order) {
-    OrderType orderType;
+template <typename Traits, typename Policy>
+auto BasicOrderbook<Traits, Policy>::ModifyOrder(OrderModify order) -> Trades {
+    PerfScope scope {recorder_, BookOperation::Modify};
 
-    if (!orders_.contains(order.GetOrderId())) {
-        std::cout << "Order does not exist" << std::endl;
+    auto entry = orders_.find(order.GetOrderId());
+    if (entry == orders_.end()) {
+        if (verbose_)
+            std::cout << "Order does not exist" << std::endl;
         return {};
     }
 
-    const auto& [existingOrder, _] = orders_.at(order.GetOrderId());
-    orderType = existingOrder->GetOrderType();
+    const auto& [level, slot] = entry->second;
+    const auto& details = level->GetDetails(slot);
+    OrderType orderType = details.orderType_;
+    OwnerId ownerId = details.ownerId_;
+    Quantity displayQuantity = details.displayQuantity_;
     
     CancelOrder(order.GetOrderId());
-    return AddOrder(order.ToOrderPointer(orderType));
+    return AddOrder(order.ToOrder(orderType, ownerId, displayQuantity));
+}
+
+template <typename Traits, typename Policy>
+OrderIds BasicOrderbook<Traits, Policy>::MassCancel() {
+    PerfScope scope {recorder_, BookOperation::MassCancel};
+
+    OrderIds cancelled;
+    cancelled.reserve(orders_.size());
+
+    // Keys of orders_ are exactly the resting orders
+    for (const auto& [orderId, _] : orders_)
+        cancelled.push_back(orderId);
+
+    // Nothing survives, drop every container wholesale instead of unlinking order by order
+    orders_.clear();
+    bids_.clear();
+    asks_.clear();
+    data_.clear();
+    owners_.clear();
+    bidWindow_.dirty_ = askWindow_.dirty_ = true;
+    RefreshSignals();
+
+    return cancelled;
+}
+
+template <typename Traits, typename Policy>
+OrderIds BasicOrderbook<Traits, Policy>::MassCancel(Side side) {
+    PerfScope scope {recorder_, BookOperation::MassCancel};
+
+    OrderIds cancelled;
+
+    if (side == Side::Buy) {
+        CancelLevels(bids_, bids_.begin(), bids_.end(), cancelled);
+    } else {
+        CancelLevels(asks_, asks_.begin(), asks_.end(), cancelled);
+    }
+    RefreshSignals();
+    return cancelled;
+}
+
+template <typename Traits, typename Policy>
+OrderIds BasicOrderbook<Traits, Policy>::MassCancel(Side side, Price minPrice, Price maxPrice) {
+    PerfScope scope {recorder_, BookOperation::MassCancel};
+
+    OrderIds cancelled;
+
+    if (minPrice > maxPrice)
+        return cancelled;
+
+    // Inclusive range, bids are ordered from the highest price down
+    if (side == Side::Buy) {
+        CancelLevels(bids_, bids_.lower_bound(maxPrice), bids_.upper_bound(minPrice), cancelled);
+    } else {
+        CancelLevels(asks_, asks_.lower_bound(minPrice), asks_.upper_bound(maxPrice), cancelled);
+    }
+    RefreshSignals();
+    return cancelled;
+}
+
+template <typename Traits, typename Policy>
+OrderIds BasicOrderbook<Traits, Policy>::MassCancel(OwnerId ownerId) {
+    PerfScope scope {recorder_, BookOperation::MassCancel};
+
+    OrderIds cancelled;
+
+    auto owner = owners_.find(ownerId);
+    if (owner == owners_.end())
+        return cancelled;
+
+    cancelled.assign(owner->second.begin(), owner->second.end());
+    owners_.erase(owner);   // Unlinks the whole chain at once
+
+    for (auto orderId : cancelled) {
+        auto entry = orders_.find(orderId);
+        auto [level, slot] = entry->second;
+        auto side = level->GetSide();
+        auto price = level->GetPrice();
+
+        UpdateLevelData(price, level->GetNode(slot).remainingQuantity_, LevelData::Action::Remove);
+        level->Erase(slot);
+        orders_.erase(entry);
+
+        if (!data_.contains(price))
+            EraseLevel(side, price);
+    }
+    RefreshSignals();
+    return cancelled;
 }
 
-std::size_t Orderbook::Size() const { 
+template <typename Traits, typename Policy>
+template <typename Levels>
+void BasicOrderbook<Traits, Policy>::LoadWindow(const Levels& levels, SignalWindow& window, Price openEdge) {
+    window = SignalWindow {};
+
+    for (auto level = levels.begin(); level != levels.end() && window.depth_ < SignalLevels; ++level, window.depth_++) {
+        auto data = data_.find(level->first);
+        window.prices_[window.depth_] = level->first;
+        window.quantities_[window.depth_] = data == data_.end() ? 0 : data->second.quantity_;
+        window.edge_ = level->first;
+    }
+
+    // Until the window is full any new level on this side lands inside it
+    if (window.depth_ < SignalLevels)
+        window.edge_ = openEdge;
+    window.dirty_ = false;
+}
+
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::RefreshSignals() {
+    if (!bidWindow_.dirty_ && !askWindow_.dirty_)
+        return;
+
+    if (bidWindow_.dirty_)
+        LoadWindow(bids_, bidWindow_, std::numeric_limits<Price>::min());
+    if (askWindow_.dirty_)
+        LoadWindow(asks_, askWindow_, std::numeric_limits<Price>::max());
+
+    // Empty slots past a side's depth hold zeros and drop out of every sum
+    using Lanes = stdx::fixed_size_simd<double, SignalLevels>;
+    Lanes bidPrices {bidWindow_.prices_.data(), stdx::element_aligned};
+    Lanes bidQuantities {bidWindow_.quantities_.data(), stdx::element_aligned};
+    Lanes askPrices {askWindow_.prices_.data(), stdx::element_aligned};
+    Lanes askQuantities {askWindow_.quantities_.data(), stdx::element_aligned};
+
+    double bidQuantity = stdx::reduce(bidQuantities);
+    double askQuantity = stdx::reduce(askQuantities);
+    double bidNotional = stdx::reduce(bidPrices * bidQuantities);
+    double askNotional = stdx::reduce(askPrices * askQuantities);
+
+    signals_ = BookSignals {};
+
+    if (bidQuantity + askQuantity > 0)
+        signals_.imbalance_ = (bidQuantity - askQuantity) / (bidQuantity + askQuantity);
+
+    if (bidWindow_.depth_ != 0 && askWindow_.depth_ != 0) {
+        double bestBidQuantity = bidWindow_.quantities_[0], bestAskQuantity = askWindow_.quantities_[0];
+        signals_.microprice_ = (bidWindow_.prices_[0] * bestAskQuantity + askWindow_.prices_[0] * bestBidQuantity) / (bestBidQuantity + bestAskQuantity);
+        signals_.depthWeightedMid_ = (bidNotional / bidQuantity + askNotional / askQuantity) / 2;
+    }
+}
+
+template <typename Traits, typename Policy>
+std::size_t BasicOrderbook<Traits, Policy>::Size() const { 
     return orders_.size(); 
 }
 
-std::size_t Orderbook::BidSize() const {
+template <typename Traits, typename Policy>
+std::size_t BasicOrderbook<Traits, Policy>::BidSize() const {
     return bids_.size();
 }
 
-std::size_t Orderbook::AskSize() const {
+template <typename Traits, typename Policy>
+std::size_t BasicOrderbook<Traits, Policy>::AskSize() const {
     return asks_.size();
 }
 
-OrderbookLevelInfos Orderbook::GetOrderInfos() const {
+template <typename Traits, typename Policy>
+auto BasicOrderbook<Traits, Policy>::GetOrderInfos() const -> OrderbookLevelInfos {
     LevelInfos bidInfos, askInfos;
     bidInfos.reserve(orders_.size());
     askInfos.reserve(orders_.size());
 
-    auto CreateLevelInfos = [](Price price, const OrderPointers& orders) {
-        Quantity quantity = std::accumulate(orders.begin(), orders.end(), (Quantity)0, [](Quantity acc, const OrderPointer& order) {
-            return acc + order->GetRemainingQuantity();
-        });
+    auto CreateLevelInfos = [](Price price, const OrderQueue& orders) {
+        Quantity quantity {};
+        for (Slot slot = orders.Front(); slot != OrderQueue::NoSlot; slot = orders.Next(slot)) {
+            const auto& node = orders.GetNode(slot);
+            quantity += node.remainingQuantity_;
+        }
         return LevelInfo{price, quantity};
     };
 
@@ -258,7 +653,23 @@ OrderbookLevelInfos Orderbook::GetOrderInfos() const {
     return OrderbookLevelInfos{bidInfos, askInfos}; 
 }
 
-void Orderbook::PrintOrderbook() const {
+template <typename Traits, typename Policy>
+std::size_t BasicOrderbook<Traits, Policy>::GetTopLevels(Side side, LevelInfo* levels, std::size_t depth) const {
+    // Quantities are maintained per level, no queue is walked
+    auto Copy = [&](const auto& book) {
+        std::size_t count {};
+        for (auto level = book.begin(); level != book.end() && count < depth; ++level, count++) {
+            auto data = data_.find(level->first);
+            levels[count] = LevelInfo{level->first, data == data_.end() ? Quantity {} : data->second.quantity_};
+        }
+        return count;
+    };
+
+    return side == Side::Buy ? Copy(bids_) : Copy(asks_);
+}
+
+template <typename Traits, typename Policy>
+void BasicOrderbook<Traits, Policy>::PrintOrderbook() const {
     OrderbookLevelInfos orderbookLevelInfos = GetOrderInfos();
     bool hasAsks = !orderbookLevelInfos.GetAsks().empty();
     bool hasBids = !orderbookLevelInfos.GetBids().empty();
@@ -305,4 +716,10 @@ void Orderbook::PrintOrderbook() const {
     }
 
     std::cout << std::endl;
-}
\ No newline at end of file
+}
+
+template class BasicOrderbook<DefaultTraits>;
+template class BasicOrderbook<WideQuantityTraits>;
+template class BasicOrderbook<CompactPriceTraits>;
+template class BasicOrderbook<DefaultTraits, ProRataPolicy>;
+template class BasicOrderbook<DefaultTraits, TopOrderProRataPolicy>;
\ No newline at end of file
@@ -1,26 +1,57 @@
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <iomanip>
 #include <format>
 #include <list>
 #include <map>
 #include <unordered_map>
+#include <memory_resource>
 #include <numeric>
 #include <algorithm>
 
+#include "BookSignals.h"
 #include "Datatypes.h"
+#include "MatchingPolicy.h"
 #include "Order.h"
+#include "OrderQueue.h"
 #include "OrderType.h"
 #include "OrderModify.h"
 #include "OrderBookLevelInfo.h"
 #include "Trade.h"
+#include "PerfCounters.h"
+#include "TradeLog.h"
+
+/*
+Orderbook over the price and quantity representation of an instrument, see InstrumentTraits,
+allocating fills across a level by Policy, see MatchingPolicy.h.
+Member definitions live in OrderBook.cpp and are instantiated there for the provided traits.
+*/
+template <typename Traits, typename Policy = FifoPolicy>
+class BasicOrderbook {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using Order = BasicOrder<Traits>;
+    using OrderModify = BasicOrderModify<Traits>;
+    using TradeInfo = BasicTradeInfo<Traits>;
+    using Trade = BasicTrade<Traits>;
+    using Trades = BasicTrades<Traits>;
+    using LevelInfo = BasicLevelInfo<Traits>;
+    using LevelInfos = BasicLevelInfos<Traits>;
+    using OrderbookLevelInfos = BasicOrderbookLevelInfos<Traits>;
+    using TradeLog = BasicTradeLog<Traits>;
+
+    static constexpr std::size_t SignalLevels = 8;     // Depth of the imbalance and depth-weighted mid window
 
-class Orderbook {
 private: 
+    using OrderQueue = ::OrderQueue<Traits>;
+    using OrderDetails = ::OrderDetails<Traits>;
+
     struct OrderEntry {
-        OrderPointer order_ {nullptr};
-        OrderPointers::iterator location_;
+        OrderQueue* level_ {nullptr};   // Level nodes are stable until the level is erased
+        Slot slot_ {OrderQueue::NoSlot};
     };
 
     struct LevelData {
@@ -30,35 +61,90 @@ private:
         enum class Action {
             Add,
             Remove,
-            Match
+            Match,
+            Refill      // Iceberg showing its next tranche, the order count is unchanged
         };
     };
 
-    std::map<Price, OrderPointers, std::greater<Price>> bids_;  // Price maps to list of order pointers
-    std::map<Price, OrderPointers, std::less<Price>> asks_;     // Price maps to list of order pointers
-    std::unordered_map<OrderId, OrderEntry> orders_;            // OrderId maps to OrderEntry
-    std::unordered_map<Price, LevelData> data_;                 // Price maps to LevelData
+    // Top levels of one side as the signal kernels read them, reloaded only once a level inside changes
+    struct SignalWindow {
+        std::array<double, SignalLevels> prices_ {};
+        std::array<double, SignalLevels> quantities_ {};
+        std::size_t depth_ {};
+        Price edge_ {};         // Worst price in the window, or the open end while it is not full
+        bool dirty_ {true};
+    };
+
+    std::pmr::memory_resource* resource_;                            // Backs every container and order below
+    std::pmr::map<Price, OrderQueue, std::greater<Price>> bids_;     // Price maps to queue of orders
+    std::pmr::map<Price, OrderQueue, std::less<Price>> asks_;        // Price maps to queue of orders
+    std::pmr::unordered_map<OrderId, OrderEntry> orders_;            // OrderId maps to OrderEntry
+    std::pmr::unordered_map<Price, LevelData> data_;                 // Price maps to LevelData
+    std::pmr::unordered_map<OwnerId, OwnerOrders> owners_;           // OwnerId maps to its resting orders
+    bool verbose_ {true};   // Report matches and rejections on std::cout
+    PerfRecorder* recorder_ {nullptr};
+    TradeLog* tradeLog_ {nullptr};
+    SignalWindow bidWindow_;
+    SignalWindow askWindow_;
+    BookSignals signals_;
+    std::pmr::vector<Slot> allocationSlots_;            // Live orders of the level being allocated, in time priority
+    std::pmr::vector<Quantity> allocationQuantities_;   // Their shown quantities
+    std::pmr::vector<Quantity> allocationFills_;        // Their shares of the incoming order
 
     bool CanMatch(Side side, Price price) const;
     bool CanFullyFill(Side side, Price price, Quantity quantity) const;
     void UpdateLevelData(Price price, Quantity quantity, LevelData::Action action);
-    Trades MatchOrders();
+    void EraseLevel(Side side, Price price);
+    void EraseOrder(OrderId orderId, const OrderDetails& details);
+    void UnlinkOwner(const OrderDetails& details);
+    bool Refill(OrderQueue& level, Slot slot);
+    template <typename Levels>
+    void CancelLevels(Levels& levels, typename Levels::iterator first, typename Levels::iterator last, OrderIds& cancelled);
+    void MatchLevel(OrderQueue& incoming, OrderQueue& resting, Trades& trades);
+    Trades MatchOrders(Side aggressor);
+    template <typename Levels>
+    void LoadWindow(const Levels& levels, SignalWindow& window, Price openEdge);
+    void RefreshSignals();
     
 public: 
-    Orderbook() = default;                      // Constructor
-    Orderbook(const Orderbook&) = delete;       // Copy constructor
-    void operator=(const Orderbook&) = delete;  // Copy assignment
-    Orderbook(Orderbook&&) = delete;            // Move constructor
-    void operator=(Orderbook&&) = delete;       // Move assignment    
-    ~Orderbook() = default;                     // Destructor
-
-    Trades AddOrder(OrderPointer order);
+    explicit BasicOrderbook(std::pmr::memory_resource* resource = std::pmr::get_default_resource());  // Constructor
+    BasicOrderbook(const BasicOrderbook&) = delete;         // Copy constructor
+    void operator=(const BasicOrderbook&) = delete;         // Copy assignment
+    BasicOrderbook(BasicOrderbook&&) = delete;              // Move constructor
+    void operator=(BasicOrderbook&&) = delete;              // Move assignment    
+    ~BasicOrderbook() = default;                            // Destructor
+
+    std::pmr::memory_resource* GetResource() const { return resource_; }
+    bool IsVerbose() const { return verbose_; }
+    void SetVerbose(bool verbose) { verbose_ = verbose; }
+    void SetRecorder(PerfRecorder* recorder) { recorder_ = recorder; }  // Must outlive the orderbook or be reset
+    void SetTradeLog(TradeLog* tradeLog) { tradeLog_ = tradeLog; }      // Must outlive the orderbook or be reset
+
+    Trades AddOrder(Order order);
     void CancelOrder(OrderId orderId);
     Trades ModifyOrder(OrderModify order);
 
+    OrderIds MassCancel();
+    OrderIds MassCancel(Side side);
+    OrderIds MassCancel(Side side, Price minPrice, Price maxPrice);
+    OrderIds MassCancel(OwnerId ownerId);
+
+    bool Contains(OrderId orderId) const { return orders_.contains(orderId); }
     std::size_t Size() const;
     std::size_t BidSize() const;
     std::size_t AskSize() const;
     OrderbookLevelInfos GetOrderInfos() const;
+    std::size_t GetTopLevels(Side side, LevelInfo* levels, std::size_t depth) const;   // Best levels first, returns how many were written
+    const BookSignals& GetSignals() const { return signals_; }
     void PrintOrderbook() const;
-};
\ No newline at end of file
+};
+
+extern template class BasicOrderbook<DefaultTraits>;
+extern template class BasicOrderbook<WideQuantityTraits>;
+extern template class BasicOrderbook<CompactPriceTraits>;
+extern template class BasicOrderbook<DefaultTraits, ProRataPolicy>;
+extern template class BasicOrderbook<DefaultTraits, TopOrderProRataPolicy>;
+
+using Orderbook = BasicOrderbook<DefaultTraits>;
+using ProRataOrderbook = BasicOrderbook<DefaultTraits, ProRataPolicy>;
+using TopOrderProRataOrderbook = BasicOrderbook<DefaultTraits, TopOrderProRataPolicy>;
\ No newline at end of file
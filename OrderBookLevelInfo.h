@@ -3,16 +3,24 @@
 #include "Datatypes.h"
 #include <iostream>
 
-struct LevelInfo {
+template <typename Traits>
+struct BasicLevelInfo {
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
     Price price_; 
     Quantity quantity_;
 };
 
-using LevelInfos = std::vector<LevelInfo>;
+template <typename Traits>
+using BasicLevelInfos = std::vector<BasicLevelInfo<Traits>>;
 
-class OrderbookLevelInfos {
+template <typename Traits>
+class BasicOrderbookLevelInfos {
 public:
-    OrderbookLevelInfos(const LevelInfos& bids, const LevelInfos& asks) 
+    using LevelInfos = BasicLevelInfos<Traits>;
+
+    BasicOrderbookLevelInfos(const LevelInfos& bids, const LevelInfos& asks) 
         : bids_ {bids}, 
           asks_ {asks} 
         { }
@@ -21,4 +29,8 @@ public:
 private:
     LevelInfos bids_;
     LevelInfos asks_;
-};
\ No newline at end of file
+};
+
+using LevelInfo = BasicLevelInfo<DefaultTraits>;
+using LevelInfos = BasicLevelInfos<DefaultTraits>;
+using OrderbookLevelInfos = BasicOrderbookLevelInfos<DefaultTraits>;
\ No newline at end of file
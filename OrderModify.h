@@ -3,9 +3,13 @@
 #include "Datatypes.h"
 #include "Order.h"
 
-class OrderModify {
+template <typename Traits>
+class BasicOrderModify {
 public:
-    OrderModify(OrderId orderId, Side side, Price price, Quantity quantity)
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
+    BasicOrderModify(OrderId orderId, Side side, Price price, Quantity quantity)
         : orderId_ {orderId}, 
           side_ {side}, 
           price_ {price}, 
@@ -17,8 +21,8 @@ public:
     Price GetPrice() const { return price_; }
     Quantity GetQuantity() const { return quantity_; }
 
-    OrderPointer ToOrderPointer(OrderType type) const {
-        return std::make_shared<Order>(type, GetOrderId(), GetSide(), GetPrice(), GetQuantity());
+    BasicOrder<Traits> ToOrder(OrderType type, OwnerId ownerId = Constants::NoOwner, Quantity displayQuantity = 0) const {
+        return BasicOrder<Traits>{type, GetOrderId(), GetSide(), GetPrice(), GetQuantity(), ownerId, displayQuantity};
     }
 
 private: 
@@ -28,3 +32,4 @@ private:
     Quantity quantity_;
 };
 
+using OrderModify = BasicOrderModify<DefaultTraits>;
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <memory_resource>
+#include <vector>
+#include "Datatypes.h"
+#include "OrderType.h"
+
+using Slot = std::uint32_t;                         // Position of an order within its level
+using OwnerOrders = std::pmr::list<OrderId>;        // Resting orders of one owner
+
+// What the matcher reads and writes on every fill, packed so two orders share a cache line
+template <typename Traits>
+struct OrderNode {
+    using Quantity = typename Traits::Quantity;
+
+    OrderId orderId_;
+    Quantity remainingQuantity_;
+    Slot next_;
+    Slot prev_;
+};
+
+static_assert(sizeof(OrderNode<WideQuantityTraits>) <= 32, "OrderNode must stay within half a cache line");
+
+// What is only needed on entry, modify, iceberg refill, reporting and cancellation by owner
+template <typename Traits>
+struct OrderDetails {
+    using Quantity = typename Traits::Quantity;
+
+    OrderType orderType_;
+    Quantity initialQuantity_;
+    Quantity displayQuantity_;      // Tranche size of an iceberg, 0 otherwise
+    Quantity reserveQuantity_;      // Hidden quantity not yet shown
+    OwnerId ownerId_;
+    OwnerOrders::iterator ownerLocation_;   // Only valid if the order has an owner
+};
+
+/*
+FIFO queue of the orders resting at one price
+
+Orders live in a slab owned by the level, hot nodes and cold details in parallel vectors
+indexed by the same slot, and are chained in time priority through slot indices. Slots are
+handed out in arrival order and recycled from a free list, so walking the queue mostly moves
+forward through contiguous memory. Unlinking any order is O(1) and slots stay valid while
+the slab grows.
+*/
+template <typename Traits>
+class OrderQueue {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using Node = OrderNode<Traits>;
+    using Details = OrderDetails<Traits>;
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    static constexpr Slot NoSlot = std::numeric_limits<Slot>::max();
+
+    OrderQueue(Side side, Price price, const allocator_type& allocator = {})
+        : side_ {side},
+          price_ {price},
+          nodes_ {allocator},
+          details_ {allocator}
+    { }
+
+    Side GetSide() const { return side_; }
+    Price GetPrice() const { return price_; }
+    bool Empty() const { return head_ == NoSlot; }
+    std::size_t Size() const { return size_; }
+
+    Slot Front() const { return head_; }
+    Slot Next(Slot slot) const { return nodes_[slot].next_; }
+    Node& GetNode(Slot slot) { return nodes_[slot]; }
+    const Node& GetNode(Slot slot) const { return nodes_[slot]; }
+    Details& GetDetails(Slot slot) { return details_[slot]; }
+    const Details& GetDetails(Slot slot) const { return details_[slot]; }
+
+    Slot PushBack(OrderId orderId, Quantity quantity, const Details& details) {
+        Slot slot;
+        if (free_ != NoSlot) {
+            slot = free_;
+            free_ = nodes_[slot].next_;
+            details_[slot] = details;
+        } else {
+            slot = static_cast<Slot>(nodes_.size());
+            nodes_.emplace_back();
+            details_.push_back(details);
+        }
+
+        nodes_[slot] = Node{orderId, quantity, NoSlot, tail_};
+        Link(slot);
+        size_++;
+        return slot;
+    }
+
+    void Erase(Slot slot) {
+        Unlink(slot);
+        size_--;
+
+        // An empty level starts over at slot 0 so the next burst of orders is contiguous again
+        if (size_ == 0) {
+            nodes_.clear();
+            details_.clear();
+            free_ = NoSlot;
+            return;
+        }
+
+        nodes_[slot].next_ = free_;
+        free_ = slot;
+    }
+
+    void PopFront() { Erase(head_); }
+
+    // Requeue an order behind every other order of the level, keeping its slot
+    void MoveToBack(Slot slot) {
+        if (slot == tail_)
+            return;
+
+        Unlink(slot);
+        nodes_[slot].next_ = NoSlot;
+        nodes_[slot].prev_ = tail_;
+        Link(slot);
+    }
+
+private:
+    Side side_;
+    Price price_;
+    std::pmr::vector<Node> nodes_;
+    std::pmr::vector<Details> details_;
+    Slot head_ {NoSlot};
+    Slot tail_ {NoSlot};
+    Slot free_ {NoSlot};
+    std::uint32_t size_ {};
+
+    void Link(Slot slot) {
+        if (tail_ == NoSlot) {
+            head_ = slot;
+        } else {
+            nodes_[tail_].next_ = slot;
+        }
+        tail_ = slot;
+    }
+
+    void Unlink(Slot slot) {
+        auto& node = nodes_[slot];
+        if (node.prev_ == NoSlot) {
+            head_ = node.next_;
+        } else {
+            nodes_[node.prev_].next_ = node.next_;
+        }
+
+        if (node.next_ == NoSlot) {
+            tail_ = node.prev_;
+        } else {
+            nodes_[node.next_].prev_ = node.prev_;
+        }
+    }
+};
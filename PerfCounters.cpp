@@ -0,0 +1,168 @@
+#include "PerfCounters.h"
+
+#include <chrono>
+#include <format>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef __linux__
+    struct CounterEvent {
+        std::uint32_t type_;
+        std::uint64_t config_;
+    };
+
+    constexpr std::array<CounterEvent, static_cast<std::size_t>(PerfCounter::Count)> Events {{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+    }};
+
+    int OpenEvent(const CounterEvent& event, int groupFd) {
+        perf_event_attr attributes {};
+        attributes.size = sizeof(attributes);
+        attributes.type = event.type_;
+        attributes.config = event.config_;
+        attributes.disabled = groupFd == -1 ? 1 : 0;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, groupFd, 0));
+    }
+#endif
+
+    std::uint64_t Now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+std::string_view ToString(BookOperation operation) {
+    switch (operation) {
+        case BookOperation::Add: return "Add";
+        case BookOperation::Cancel: return "Cancel";
+        case BookOperation::Modify: return "Modify";
+        case BookOperation::MassCancel: return "MassCancel";
+        case BookOperation::Match: return "Match";
+        default: return "Unknown";
+    }
+}
+
+PerfRecorder::PerfRecorder(bool useCounters) {
+    fds_.fill(-1);
+
+#ifdef __linux__
+    if (!useCounters)
+        return;
+
+    // The first counter that opens leads the group, the others are read along with it
+    int leader = -1;
+    for (std::size_t i = 0; i < CounterCount; i++) {
+        int fd = OpenEvent(Events[i], leader);
+        if (fd < 0)
+            continue;
+        if (leader == -1)
+            leader = fd;
+        fds_[i] = fd;
+        slots_[i] = opened_++;
+    }
+
+    if (leader != -1) {
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#else
+    (void)useCounters;
+#endif
+}
+
+PerfRecorder::~PerfRecorder() {
+#ifdef __linux__
+    for (int fd : fds_)
+        if (fd >= 0)
+            close(fd);
+#endif
+}
+
+CounterValues PerfRecorder::Snapshot() const {
+    CounterValues values;
+
+#ifdef __linux__
+    if (opened_ > 0) {
+        // PERF_FORMAT_GROUP layout: number of counters followed by their values
+        std::array<std::uint64_t, CounterCount + 1> buffer {};
+        int leader = -1;
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                leader = fd;
+                break;
+            }
+        }
+
+        if (read(leader, buffer.data(), sizeof(buffer)) > 0) {
+            for (std::size_t i = 0; i < CounterCount; i++)
+                if (fds_[i] >= 0)
+                    values.counters_[i] = buffer[1 + slots_[i]];
+        }
+    }
+#endif
+
+    values.nanoseconds_ = Now();
+    return values;
+}
+
+void PerfRecorder::Record(BookOperation operation, const CounterValues& begin, const CounterValues& end) {
+    auto& stats = stats_[static_cast<std::size_t>(operation)];
+    stats.calls_++;
+    for (std::size_t i = 0; i < CounterCount; i++)
+        stats.total_.counters_[i] += end.counters_[i] - begin.counters_[i];
+    stats.total_.nanoseconds_ += end.nanoseconds_ - begin.nanoseconds_;
+}
+
+void PerfRecorder::Merge(const PerfRecorder& other) {
+    for (std::size_t op = 0; op < stats_.size(); op++) {
+        stats_[op].calls_ += other.stats_[op].calls_;
+        for (std::size_t i = 0; i < CounterCount; i++)
+            stats_[op].total_.counters_[i] += other.stats_[op].total_.counters_[i];
+        stats_[op].total_.nanoseconds_ += other.stats_[op].total_.nanoseconds_;
+    }
+
+    for (std::size_t i = 0; i < CounterCount; i++)
+        merged_[i] = merged_[i] || other.HasCounter(static_cast<PerfCounter>(i));
+}
+
+void PerfRecorder::Print(std::ostream& stream) const {
+    auto PerCall = [this](const OperationStats& stats, PerfCounter counter, int precision) -> std::string {
+        if (!HasCounter(counter))
+            return "-";
+        double value = static_cast<double>(stats.total_.Get(counter)) / stats.calls_;
+        return precision == 0 ? std::format("{:.0f}", value) : std::format("{:.2f}", value);
+    };
+
+    stream << std::format("{:<12}{:>12}{:>10}{:>12}{:>8}{:>12}{:>12}{:>12}\n",
+        "Operation", "Calls", "ns/op", "cycles/op", "IPC", "cache/op", "branch/op", "dtlb/op");
+
+    for (std::size_t op = 0; op < stats_.size(); op++) {
+        const auto& stats = stats_[op];
+        if (stats.calls_ == 0)
+            continue;
+
+        std::string ipc = "-";
+        if (HasCounter(PerfCounter::Cycles) && HasCounter(PerfCounter::Instructions) && stats.total_.Get(PerfCounter::Cycles) > 0)
+            ipc = std::format("{:.2f}", static_cast<double>(stats.total_.Get(PerfCounter::Instructions)) / stats.total_.Get(PerfCounter::Cycles));
+
+        stream << std::format("{:<12}{:>12}{:>10.0f}{:>12}{:>8}{:>12}{:>12}{:>12}\n",
+            ToString(static_cast<BookOperation>(op)), stats.calls_,
+            static_cast<double>(stats.total_.nanoseconds_) / stats.calls_,
+            PerCall(stats, PerfCounter::Cycles, 0), ipc,
+            PerCall(stats, PerfCounter::CacheMisses, 2),
+            PerCall(stats, PerfCounter::BranchMisses, 2),
+            PerCall(stats, PerfCounter::DtlbMisses, 2));
+    }
+}
\ No newline at end of file
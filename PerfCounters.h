@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+
+/*
+Hardware performance counters around Orderbook operations
+
+On Linux a counter group (cycles, instructions, cache misses, branch misses, dTLB load misses)
+is opened with perf_event_open for the calling thread, user space only. Counters the kernel
+or the machine does not provide are left out; when none can be opened the recorder degrades
+to wall-clock timing. Reading the group costs one syscall per snapshot.
+
+A recorder belongs to one thread. Recorders of several threads are combined with Merge.
+*/
+
+enum class BookOperation {
+    Add,
+    Cancel,
+    Modify,
+    MassCancel,
+    Match,      // Nested inside Add and Modify
+    Count
+};
+
+enum class PerfCounter {
+    Cycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    DtlbMisses,
+    Count
+};
+
+struct CounterValues {
+    std::array<std::uint64_t, static_cast<std::size_t>(PerfCounter::Count)> counters_ {};
+    std::uint64_t nanoseconds_ {};
+
+    std::uint64_t Get(PerfCounter counter) const { return counters_[static_cast<std::size_t>(counter)]; }
+};
+
+struct OperationStats {
+    std::uint64_t calls_ {};
+    CounterValues total_;
+};
+
+class PerfRecorder {
+public:
+    explicit PerfRecorder(bool useCounters = true);
+    PerfRecorder(const PerfRecorder&) = delete;         // Copy constructor
+    void operator=(const PerfRecorder&) = delete;       // Copy assignment
+    PerfRecorder(PerfRecorder&&) = delete;              // Move constructor
+    void operator=(PerfRecorder&&) = delete;            // Move assignment
+    ~PerfRecorder();                                    // Destructor
+
+    bool HasCounter(PerfCounter counter) const { return fds_[static_cast<std::size_t>(counter)] >= 0 || merged_[static_cast<std::size_t>(counter)]; }
+    const OperationStats& GetStats(BookOperation operation) const { return stats_[static_cast<std::size_t>(operation)]; }
+
+    CounterValues Snapshot() const;
+    void Record(BookOperation operation, const CounterValues& begin, const CounterValues& end);
+    void Merge(const PerfRecorder& other);
+    void Print(std::ostream& stream = std::cout) const;
+
+private:
+    friend class PerfScope;
+
+    static constexpr std::size_t CounterCount = static_cast<std::size_t>(PerfCounter::Count);
+
+    std::array<int, CounterCount> fds_;
+    std::array<bool, CounterCount> merged_ {};      // Counter was available in a merged recorder
+    std::array<std::size_t, CounterCount> slots_ {};   // Position of each counter in a group read
+    std::size_t opened_ {};
+    std::array<OperationStats, static_cast<std::size_t>(BookOperation::Count)> stats_ {};
+    int depth_ {};      // Nesting of entry point scopes
+};
+
+// Records the enclosed operation into recorder, if any. Entry points only count when they are
+// the outermost scope so Modify is not also booked as a Cancel and an Add, Match always counts.
+class PerfScope {
+public:
+    PerfScope(PerfRecorder* recorder, BookOperation operation)
+        : recorder_ {recorder},
+          operation_ {operation}
+    {
+        if (recorder_ == nullptr)
+            return;
+        counted_ = operation_ == BookOperation::Match || recorder_->depth_ == 0;
+        recorder_->depth_++;
+        if (counted_)
+            begin_ = recorder_->Snapshot();
+    }
+
+    PerfScope(const PerfScope&) = delete;
+    void operator=(const PerfScope&) = delete;
+
+    ~PerfScope() {
+        if (recorder_ == nullptr)
+            return;
+        if (counted_)
+            recorder_->Record(operation_, begin_, recorder_->Snapshot());
+        recorder_->depth_--;
+    }
+
+private:
+    PerfRecorder* recorder_;
+    BookOperation operation_;
+    bool counted_ {};
+    CounterValues begin_;
+};
+
+std::string_view ToString(BookOperation operation);
@@ -0,0 +1,171 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <optional>
+#include <unordered_set>
+#include "MemoryArena.h"
+
+namespace {
+    constexpr std::size_t StreamBufferSize = 1 << 20;
+    constexpr std::size_t ArenaCapacity = 32 * 1024 * 1024;     // Per worker, a larger book spills to the heap
+}
+
+ReplayDriver::ReplayDriver(std::size_t threads)
+    : pool_ {threads}
+{ }
+
+std::vector<std::filesystem::path> ReplayDriver::CollectFiles(const std::filesystem::path& input) {
+    std::vector<std::filesystem::path> files;
+
+    if (std::filesystem::is_directory(input)) {
+        for (const auto& entry : std::filesystem::directory_iterator {input})
+            if (entry.is_regular_file())
+                files.push_back(entry.path());
+    } else {
+        std::ifstream manifest {input};
+        if (!manifest.is_open())
+            throw std::runtime_error(std::format("Manifest {} not found", input.string()));
+
+        std::string line;
+        while (std::getline(manifest, line)) {
+            if (line.empty())
+                continue;
+            std::filesystem::path path {line};
+            files.push_back(path.is_absolute() ? path : input.parent_path() / path);
+        }
+    }
+
+    // Largest files first so the long replays do not end up alone at the tail of the run
+    std::vector<std::pair<std::uintmax_t, std::filesystem::path>> sized;
+    for (auto& file : files)
+        sized.emplace_back(std::filesystem::exists(file) ? std::filesystem::file_size(file) : 0, std::move(file));
+    std::stable_sort(sized.begin(), sized.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    files.clear();
+    for (auto& [_, file] : sized)
+        files.push_back(std::move(file));
+    return files;
+}
+
+std::filesystem::path ReplayDriver::GetOutputName(const std::filesystem::path& file, const std::filesystem::path& root) {
+    // Keeps the layout below the root, jan/AAPL.txt and feb/AAPL.txt stay apart
+    auto name = file.lexically_normal().lexically_relative(root.empty() ? std::filesystem::path {"."} : root.lexically_normal());
+    if (name.empty() || *name.begin() == "..")
+        return file.filename();
+    return name;
+}
+
+ReplaySummaries ReplayDriver::Run(const std::filesystem::path& input, const std::filesystem::path& outputDirectory) {
+    auto files = CollectFiles(input);
+    auto root = std::filesystem::is_directory(input) ? input : input.parent_path();
+
+    // Two files writing the same outputs would overwrite each other's results
+    std::vector<std::filesystem::path> outputs;
+    std::unordered_set<std::string> names;
+    for (const auto& file : files) {
+        auto name = GetOutputName(file, root);
+        if (!names.insert(name.string()).second)
+            throw std::runtime_error(std::format("Replay outputs of {} collide with another input", file.string()));
+        outputs.push_back(outputDirectory / name);
+        std::filesystem::create_directories(outputs.back().parent_path());
+    }
+
+    // Every task writes its own slot, no synchronisation needed beyond Wait
+    ReplaySummaries summaries(files.size());
+    for (std::size_t i = 0; i < files.size(); i++) {
+        pool_.Submit([this, &summaries, &files, &outputs, i] {
+            summaries[i] = ReplayFile(files[i], outputs[i]);
+        });
+    }
+    pool_.Wait();
+
+    return summaries;
+}
+
+ReplaySummary ReplayDriver::ReplayFile(const std::filesystem::path& path, const std::filesystem::path& output) {
+    ReplaySummary summary;
+    summary.input_ = path;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<char> inputBuffer(StreamBufferSize), outputBuffer(StreamBufferSize);
+    std::ifstream file;
+    file.rdbuf()->pubsetbuf(inputBuffer.data(), inputBuffer.size());
+    file.open(path);
+
+    std::ofstream trades;
+    trades.rdbuf()->pubsetbuf(outputBuffer.data(), outputBuffer.size());
+    trades.open(output.string() + ".trades");
+
+    // Counters follow the calling thread, so the recorder is opened on the worker
+    std::optional<PerfRecorder> recorder;
+    if (instrumented_)
+        recorder.emplace();
+
+    // The arena is not thread safe, every worker owns one on its own NUMA node and the books
+    // it replays reuse the blocks of the previous ones
+    thread_local HugePageArena arena {ArenaCapacity};
+    Orderbook orderbook {&arena};
+    orderbook.SetVerbose(false);
+    orderbook.SetRecorder(recorder ? &*recorder : nullptr);
+
+    try {
+        if (!file.is_open())
+            throw std::runtime_error("File not found");
+
+        // Counted as applied, a file failing halfway still reports what reached the book
+        handler_.ReadFromStream(file, orderbook, [&](const Info&, const Trades& fills) {
+            summary.commands_++;
+            for (const auto& trade : fills) {
+                const auto& bid = trade.GetBidTrade();
+                const auto& ask = trade.GetAskTrade();
+                trades << bid.orderId_ << ' ' << bid.price_ << ' ' << ask.orderId_ << ' ' << ask.price_ << ' ' << bid.quantity_ << '\n';
+                summary.volume_ += bid.quantity_;
+            }
+            summary.trades_ += fills.size();
+        });
+    } catch (const std::exception& error) {
+        summary.error_ = error.what();
+    }
+
+    if (recorder) {
+        std::lock_guard lock {perfMutex_};
+        perfStats_.Merge(*recorder);
+    }
+
+    summary.restingOrders_ = orderbook.Size();
+    summary.bidLevels_ = orderbook.BidSize();
+    summary.askLevels_ = orderbook.AskSize();
+    summary.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream summaryFile {output.string() + ".summary"};
+    summaryFile << "input: " << path.string() << '\n'
+                << "commands: " << summary.commands_ << '\n'
+                << "trades: " << summary.trades_ << '\n'
+                << "volume: " << summary.volume_ << '\n'
+                << "resting_orders: " << summary.restingOrders_ << '\n'
+                << "bid_levels: " << summary.bidLevels_ << '\n'
+                << "ask_levels: " << summary.askLevels_ << '\n'
+                << "seconds: " << summary.seconds_ << '\n';
+    if (!summary.error_.empty())
+        summaryFile << "error: " << summary.error_ << '\n';
+
+    return summary;
+}
+
+void ReplayDriver::PrintSummaries(const ReplaySummaries& summaries, double seconds) {
+    std::size_t commands {}, trades {}, failed {};
+
+    for (const auto& summary : summaries) {
+        commands += summary.commands_;
+        trades += summary.trades_;
+        if (!summary.error_.empty()) {
+            failed++;
+            std::cerr << std::format("{}: {}", summary.input_.string(), summary.error_) << std::endl;
+        }
+    }
+
+    std::cout << std::format("Replayed {} files ({} failed), {} commands, {} trades in {:.3f}s ({:.0f} commands/s)",
+        summaries.size(), failed, commands, trades, seconds, seconds > 0 ? commands / seconds : 0.0) << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "InputHandler.h"
+#include "ThreadPool.h"
+#include "PerfCounters.h"
+
+/*
+Parallel replay of independent flow files
+
+Input is either a directory, whose regular files are all replayed, or a manifest listing
+one flow file per line (relative paths resolve against the manifest's directory).
+Every file runs through its own Orderbook on the work stealing pool, parsed and matched
+line by line, and writes <name>.trades and <name>.summary into the output directory. The
+name is the file's path below the input directory or the manifest's directory, so files of
+the same name in different subdirectories keep apart, inputs whose outputs would still
+collide are rejected before anything runs.
+
+Trade lines: BidOrderId BidPrice AskOrderId AskPrice Quantity
+
+Books are backed by a HugePageArena owned by the worker thread, created with its first file.
+
+With instrumentation on, every book records its operations on the worker's counters and
+the results are merged into one table over all files.
+*/
+
+struct ReplaySummary {
+    std::filesystem::path input_;
+    std::size_t commands_ {};
+    std::size_t trades_ {};
+    std::int64_t volume_ {};
+    std::size_t restingOrders_ {};
+    std::size_t bidLevels_ {};
+    std::size_t askLevels_ {};
+    double seconds_ {};
+    std::string error_;         // Empty if the file replayed completely
+};
+
+using ReplaySummaries = std::vector<ReplaySummary>;
+
+class ReplayDriver {
+public:
+    explicit ReplayDriver(std::size_t threads = std::thread::hardware_concurrency());
+
+    ReplaySummaries Run(const std::filesystem::path& input, const std::filesystem::path& outputDirectory);
+    static std::vector<std::filesystem::path> CollectFiles(const std::filesystem::path& input);
+    static std::filesystem::path GetOutputName(const std::filesystem::path& file, const std::filesystem::path& root);
+    static void PrintSummaries(const ReplaySummaries& summaries, double seconds);
+
+    void SetInstrumentation(bool instrumented) { instrumented_ = instrumented; }
+    const PerfRecorder& GetPerfStats() const { return perfStats_; }
+
+private:
+    ThreadPool pool_;
+    InputHandler handler_;
+    bool instrumented_ {false};
+    std::mutex perfMutex_;
+    PerfRecorder perfStats_ {false};    // Merged from the per-file recorders
+
+    ReplaySummary ReplayFile(const std::filesystem::path& path, const std::filesystem::path& output);   // Writes output.trades and output.summary
+};
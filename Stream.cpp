@@ -0,0 +1,277 @@
+#include "Stream.h"
+
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+namespace {
+    template <typename Number>
+    void AppendNumber(std::string& output, Number number) {
+        char buffer[24];
+        auto [end, _] = std::to_chars(buffer, buffer + sizeof(buffer), number);
+        output.append(buffer, end);
+    }
+
+    char ToLetter(ActionType action) {
+        switch (action) {
+            case ActionType::Add: return 'A';
+            case ActionType::Modify: return 'M';
+            case ActionType::Cancel: return 'C';
+            case ActionType::MassCancel: return 'X';
+        }
+        return '?';
+    }
+}
+
+StreamDriver::StreamDriver(int inputFd, int outputFd)
+    : inputFd_ {inputFd},
+      outputFd_ {outputFd}
+{
+    if (pipe(wakeupFds_) != 0)
+        throw std::runtime_error(std::format("Creating the wakeup pipe failed: {}", std::strerror(errno)));
+    output_.reserve(OutputBufferSize + 256);
+}
+
+StreamDriver::~StreamDriver() {
+    close(wakeupFds_[0]);
+    close(wakeupFds_[1]);
+}
+
+StreamSummary StreamDriver::Run(Orderbook& orderbook) {
+    StreamSummary summary;
+    auto start = std::chrono::steady_clock::now();
+
+    // The book's own reporting would interleave with the output stream
+    bool verbose = orderbook.IsVerbose();
+    orderbook.SetVerbose(false);
+
+    std::thread reader {[this] { Read(); }};
+    std::thread parser {[this] { Parse(); }};
+
+    try {
+        Infos batch;
+        while (true) {
+            // Nothing parsed yet, hand out what is buffered before waiting for more
+            if (!batches_.TryPop(batch)) {
+                Flush();
+                if (!batches_.Pop(batch))
+                    break;
+            }
+
+            for (const auto& info : batch) {
+                // The book reports rejections only on std::cout, whether it acted is read off its orders
+                bool existed = orderbook.Contains(info.orderId_);
+                Trades trades;
+                bool applied = true;
+                try {
+                    trades = handler_.ProcessInfo(info, orderbook);
+                    if (info.action_ == ActionType::Add) {
+                        applied = !existed && (!trades.empty() || orderbook.Contains(info.orderId_));
+                    } else if (info.action_ != ActionType::MassCancel) {
+                        applied = existed;
+                    }
+                } catch (const std::logic_error&) {
+                    // Parsed but not a valid order, e.g. a display quantity on a FillAndKill, the book is untouched
+                    applied = false;
+                }
+
+                WriteAck(info, applied);
+                WriteTrades(trades);
+                summary.trades_ += trades.size();
+            }
+
+            summary.commands_ += batch.size();
+        }
+        Flush();
+    } catch (...) {
+        Fail(std::current_exception());
+    }
+
+    reader.join();
+    parser.join();
+    orderbook.SetVerbose(verbose);
+    summary.seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (error_)
+        std::rethrow_exception(error_);
+    return summary;
+}
+
+void StreamDriver::Read() {
+    try {
+        while (true) {
+            // Wait for input or a wakeup, a blocking read would outlive a failure on an idle feed
+            pollfd fds[] {{inputFd_, POLLIN, 0}, {wakeupFds_[0], POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::runtime_error(std::format("Waiting for the command stream failed: {}", std::strerror(errno)));
+            }
+            if (fds[1].revents != 0)
+                return;
+
+            Block block {std::make_unique_for_overwrite<char[]>(BlockSize)};
+
+            ssize_t bytes = read(inputFd_, block.data_.get(), BlockSize);
+            if (bytes < 0) {
+                if (errno == EINTR)
+                    continue;
+                throw std::runtime_error(std::format("Reading the command stream failed: {}", std::strerror(errno)));
+            }
+            if (bytes == 0)
+                break;
+
+            block.size_ = static_cast<std::size_t>(bytes);
+            if (!blocks_.Push(std::move(block)))
+                return;
+        }
+        blocks_.Close();
+    } catch (...) {
+        Fail(std::current_exception());
+    }
+}
+
+void StreamDriver::Parse() {
+    try {
+        std::string partial;    // Line cut off by the end of the previous block
+        Infos batch;
+        batch.reserve(BatchSize);
+
+        auto PushBatch = [&] {
+            if (batch.empty())
+                return true;
+            bool pushed = batches_.Push(std::move(batch));
+            batch = Infos {};
+            batch.reserve(BatchSize);
+            return pushed;
+        };
+
+        auto ParseLine = [&](std::string_view line) {
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if (line.empty())
+                return true;
+
+            // Commands ahead of a bad line are still applied, whether it is unknown or malformed
+            Info info;
+            bool parsed {};
+            try {
+                parsed = handler_.TryParseInfo(line, info);
+            } catch (...) {
+                PushBatch();
+                std::cerr << line << std::endl;
+                throw;
+            }
+            if (!parsed) {
+                PushBatch();
+                std::cerr << line << std::endl;
+                throw std::logic_error("Invalid input");
+            }
+
+            batch.push_back(info);
+            return batch.size() < BatchSize || PushBatch();
+        };
+
+        Block block;
+        while (blocks_.Pop(block)) {
+            std::string_view data {block.data_.get(), block.size_};
+            std::size_t start {}, end {};
+
+            if (!partial.empty()) {
+                end = data.find('\n');
+                if (end == std::string_view::npos) {
+                    partial.append(data);
+                    continue;
+                }
+                partial.append(data.substr(0, end));
+                if (!ParseLine(partial))
+                    return;
+                partial.clear();
+                start = end + 1;
+            }
+
+            while ((end = data.find('\n', start)) != std::string_view::npos) {
+                if (!ParseLine(data.substr(start, end - start)))
+                    return;
+                start = end + 1;
+            }
+            partial.assign(data.substr(start));
+
+            // Hand over whatever the block held so a trickling feed is not held back by batching
+            if (!PushBatch())
+                return;
+        }
+
+        if (!ParseLine(partial) || !PushBatch())
+            return;
+        batches_.Close();
+    } catch (...) {
+        Fail(std::current_exception());
+    }
+}
+
+void StreamDriver::Fail(std::exception_ptr error) {
+    {
+        std::lock_guard lock {errorMutex_};
+        if (!error_)
+            error_ = error;
+    }
+
+    // Unblock every stage, each one stops on its next push, pop or poll
+    blocks_.Close();
+    batches_.Close();
+    char wakeup {};
+    [[maybe_unused]] auto written = write(wakeupFds_[1], &wakeup, 1);
+}
+
+void StreamDriver::WriteAck(const Info& info, bool applied) {
+    output_ += applied ? "ACK " : "REJ ";
+    output_ += ToLetter(info.action_);
+    if (info.action_ != ActionType::MassCancel) {
+        output_ += ' ';
+        AppendNumber(output_, info.orderId_);
+    }
+    output_ += '\n';
+}
+
+void StreamDriver::WriteTrades(const Trades& trades) {
+    for (const auto& trade : trades) {
+        const auto& [bidOrderId, bidPrice, quantity] = trade.GetBidTrade();
+        const auto& [askOrderId, askPrice, _] = trade.GetAskTrade();
+
+        output_ += "TRADE ";
+        AppendNumber(output_, bidOrderId);
+        output_ += ' ';
+        AppendNumber(output_, bidPrice);
+        output_ += ' ';
+        AppendNumber(output_, askOrderId);
+        output_ += ' ';
+        AppendNumber(output_, askPrice);
+        output_ += ' ';
+        AppendNumber(output_, quantity);
+        output_ += '\n';
+    }
+
+    if (output_.size() >= OutputBufferSize)
+        Flush();
+}
+
+void StreamDriver::Flush() {
+    std::size_t written {};
+
+    while (written < output_.size()) {
+        ssize_t bytes = write(outputFd_, output_.data() + written, output_.size() - written);
+        if (bytes < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::runtime_error(std::format("Writing the output stream failed: {}", std::strerror(errno)));
+        }
+        written += static_cast<std::size_t>(bytes);
+    }
+    output_.clear();
+}
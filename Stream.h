@@ -0,0 +1,76 @@
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "BoundedQueue.h"
+#include "InputHandler.h"
+
+/*
+Pipelined ingestion of an unbounded command stream
+
+A reader thread pulls large blocks from a file descriptor (stdin, a FIFO or a file), a parser
+thread cuts them into lines and parses them in batches, and the calling thread applies the
+batches to the orderbook. Bounded queues between the stages hold a fast producer back
+instead of buffering the whole stream when the matcher falls behind. The reader polls the
+input together with a wakeup pipe, so a failure stops it even while the feed is idle.
+
+Acks and trades are written to the output descriptor through one large buffer, flushed when
+it fills up and whenever the matcher runs out of input, so a slow feed still sees its acks.
+
+ACK A 7                                                 // Add, Modify or Cancel applied, with its OrderId
+REJ C 7                                                 // Not applied: unknown or duplicate OrderId, unfillable
+                                                        // FillAndKill, FillOrKill or Market order, or an order
+                                                        // the book refuses, a display quantity on a non GoodUntilCancel
+ACK X                                                   // Mass cancel applied
+TRADE BidOrderId BidPrice AskOrderId AskPrice Quantity  // Following the ack of the command that traded
+*/
+
+struct StreamSummary {
+    std::size_t commands_ {};
+    std::size_t trades_ {};
+    double seconds_ {};
+};
+
+class StreamDriver {
+public:
+    StreamDriver(int inputFd, int outputFd);
+    StreamDriver(const StreamDriver&) = delete;         // Copy constructor
+    void operator=(const StreamDriver&) = delete;       // Copy assignment
+    StreamDriver(StreamDriver&&) = delete;              // Move constructor
+    void operator=(StreamDriver&&) = delete;            // Move assignment
+    ~StreamDriver();                                    // Destructor
+
+    StreamSummary Run(Orderbook& orderbook);
+
+private:
+    static constexpr std::size_t BlockSize = 1 << 20;
+    static constexpr std::size_t BlockQueueDepth = 8;
+    static constexpr std::size_t BatchSize = 1024;
+    static constexpr std::size_t BatchQueueDepth = 64;
+    static constexpr std::size_t OutputBufferSize = 1 << 20;
+
+    struct Block {
+        std::unique_ptr<char[]> data_;
+        std::size_t size_ {};
+    };
+
+    int inputFd_;
+    int outputFd_;
+    int wakeupFds_[2];              // Written by Fail to stop a reader waiting on an idle input
+    InputHandler handler_;
+    BoundedQueue<Block> blocks_ {BlockQueueDepth};
+    BoundedQueue<Infos> batches_ {BatchQueueDepth};
+    std::mutex errorMutex_;
+    std::exception_ptr error_;      // First failure of any stage, guarded by errorMutex_
+    std::string output_;
+
+    void Read();
+    void Parse();
+    void Fail(std::exception_ptr error);
+
+    void WriteAck(const Info& info, bool applied);
+    void WriteTrades(const Trades& trades);
+    void Flush();
+};
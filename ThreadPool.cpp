@@ -0,0 +1,113 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+    thread_local const ThreadPool* currentPool {nullptr};
+    thread_local std::size_t currentWorker {};
+}
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    threads = std::max<std::size_t>(threads, 1);
+
+    for (std::size_t i = 0; i < threads; i++)
+        queues_.push_back(std::make_unique<Queue>());
+
+    for (std::size_t i = 0; i < threads; i++)
+        workers_.emplace_back([this, i] { Work(i); });
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock {mutex_};
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+void ThreadPool::Submit(Task task) {
+    std::size_t index = currentPool == this ? currentWorker : next_++ % queues_.size();
+
+    {
+        std::lock_guard lock {queues_[index]->mutex_};
+        queues_[index]->tasks_.push_back(std::move(task));
+    }
+    {
+        std::lock_guard lock {mutex_};
+        queued_++;
+        pending_++;
+    }
+    wake_.notify_one();
+}
+
+void ThreadPool::Wait() {
+    std::unique_lock lock {mutex_};
+    idle_.wait(lock, [this] { return pending_ == 0; });
+
+    if (error_) {
+        auto error = std::exchange(error_, nullptr);
+        std::rethrow_exception(error);
+    }
+}
+
+bool ThreadPool::TryTake(std::size_t index, Task& task) {
+    // Own work newest first, it is the most likely to still be in cache
+    {
+        auto& queue = *queues_[index];
+        std::lock_guard lock {queue.mutex_};
+        if (!queue.tasks_.empty()) {
+            task = std::move(queue.tasks_.back());
+            queue.tasks_.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest work of the others
+    for (std::size_t i = 1; i < queues_.size(); i++) {
+        auto& queue = *queues_[(index + i) % queues_.size()];
+        std::lock_guard lock {queue.mutex_};
+        if (!queue.tasks_.empty()) {
+            task = std::move(queue.tasks_.front());
+            queue.tasks_.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Work(std::size_t index) {
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        // Reserve one of the queued tasks, it is guaranteed to be in one of the deques
+        {
+            std::unique_lock lock {mutex_};
+            wake_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+            if (queued_ == 0)
+                return;
+            queued_--;
+        }
+
+        Task task;
+        while (!TryTake(index, task))
+            std::this_thread::yield();
+
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard lock {mutex_};
+        if (error && !error_)
+            error_ = error;
+        if (--pending_ == 0)
+            idle_.notify_all();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+Work stealing thread pool
+
+Every worker owns a deque. It takes its own work from the back and, once that runs dry,
+steals from the front of the other workers' deques. Tasks submitted from a worker land
+in its own deque, tasks submitted from outside are spread round robin.
+The first exception thrown by a task is rethrown from Wait.
+*/
+
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;         // Copy constructor
+    void operator=(const ThreadPool&) = delete;     // Copy assignment
+    ThreadPool(ThreadPool&&) = delete;              // Move constructor
+    void operator=(ThreadPool&&) = delete;          // Move assignment
+    ~ThreadPool();                                  // Destructor, finishes queued tasks
+
+    std::size_t Size() const { return workers_.size(); }
+    void Submit(Task task);
+    void Wait();
+
+private:
+    struct Queue {
+        std::mutex mutex_;
+        std::deque<Task> tasks_;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::size_t pending_ {};        // Submitted but not yet finished, guarded by mutex_
+    std::size_t queued_ {};         // Submitted but not yet taken, guarded by mutex_
+    std::atomic<std::size_t> next_ {};
+    std::exception_ptr error_;      // Guarded by mutex_
+    bool stopping_ {false};
+
+    bool TryTake(std::size_t index, Task& task);
+    void Work(std::size_t index);
+};
@@ -4,15 +4,22 @@
 #include "Datatypes.h"
 #include "Order.h"
 
-struct TradeInfo {
+template <typename Traits>
+struct BasicTradeInfo {
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
     OrderId orderId_;
     Price price_;
     Quantity quantity_;
 };
 
-class Trade {
+template <typename Traits>
+class BasicTrade {
 public: 
-    Trade(const TradeInfo& bidTrade, const TradeInfo& askTrade)
+    using TradeInfo = BasicTradeInfo<Traits>;
+
+    BasicTrade(const TradeInfo& bidTrade, const TradeInfo& askTrade)
         : bidTrade_ {bidTrade},
           askTrade_ {askTrade} 
     { };
@@ -25,4 +32,9 @@ private:
     TradeInfo askTrade_;
 };
 
-using Trades = std::vector<Trade>;
\ No newline at end of file
+template <typename Traits>
+using BasicTrades = std::vector<BasicTrade<Traits>>;
+
+using TradeInfo = BasicTradeInfo<DefaultTraits>;
+using Trade = BasicTrade<DefaultTraits>;
+using Trades = BasicTrades<DefaultTraits>;
\ No newline at end of file
@@ -0,0 +1,273 @@
+#include "TradeLog.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <experimental/simd>
+
+namespace stdx = std::experimental;
+
+// Column kernels. Every column type is widened into 64 bit lanes, so one kernel serves all traits
+// and sums cannot overflow. The tail shorter than a full vector is finished in scalar code.
+namespace {
+    constexpr std::size_t Lanes = 8;
+    constexpr std::size_t DenseSpanLimit = 1 << 20;     // Widest price range histogrammed per price
+    using VolumeLanes = stdx::fixed_size_simd<Volume, Lanes>;
+    using OrderIdLanes = stdx::fixed_size_simd<OrderId, Lanes>;
+
+    struct PriceRange {
+        Volume low_;
+        Volume high_;
+    };
+
+    template <typename Quantity>
+    Volume SumQuantities(const Quantity* quantities, std::size_t count) {
+        VolumeLanes sum(0);
+        std::size_t row = 0;
+        for (; row + Lanes <= count; row += Lanes)
+            sum += VolumeLanes(quantities + row, stdx::element_aligned);
+
+        Volume volume = stdx::reduce(sum);
+        for (; row < count; row++)
+            volume += quantities[row];
+        return volume;
+    }
+
+    template <typename Price, typename Quantity>
+    Volume SumNotional(const Price* prices, const Quantity* quantities, std::size_t count) {
+        VolumeLanes sum(0);
+        std::size_t row = 0;
+        for (; row + Lanes <= count; row += Lanes)
+            sum += VolumeLanes(prices + row, stdx::element_aligned) * VolumeLanes(quantities + row, stdx::element_aligned);
+
+        Volume notional = stdx::reduce(sum);
+        for (; row < count; row++)
+            notional += static_cast<Volume>(prices[row]) * quantities[row];
+        return notional;
+    }
+
+    // count must not be 0
+    template <typename Price>
+    PriceRange GetPriceRange(const Price* prices, std::size_t count) {
+        VolumeLanes low(prices[0]), high(prices[0]);
+        std::size_t row = 0;
+        for (; row + Lanes <= count; row += Lanes) {
+            VolumeLanes lanes(prices + row, stdx::element_aligned);
+            low = stdx::min(low, lanes);
+            high = stdx::max(high, lanes);
+        }
+
+        PriceRange range {stdx::hmin(low), stdx::hmax(high)};
+        for (; row < count; row++) {
+            range.low_ = std::min<Volume>(range.low_, prices[row]);
+            range.high_ = std::max<Volume>(range.high_, prices[row]);
+        }
+        return range;
+    }
+
+    // Quantity of the rows where either order id matches, summed in unsigned lanes so the
+    // mask of the id comparison applies directly, two's complement makes the result exact
+    template <typename Quantity>
+    Volume SumMatching(const OrderId* bids, const OrderId* asks, const Quantity* quantities, std::size_t count, OrderId orderId) {
+        OrderIdLanes target(orderId), sum(0);
+        std::size_t row = 0;
+        for (; row + Lanes <= count; row += Lanes) {
+            auto matched = OrderIdLanes(bids + row, stdx::element_aligned) == target || OrderIdLanes(asks + row, stdx::element_aligned) == target;
+            stdx::where(matched, sum) += stdx::static_simd_cast<OrderIdLanes>(VolumeLanes(quantities + row, stdx::element_aligned));
+        }
+
+        Volume filled = static_cast<Volume>(stdx::reduce(sum));
+        for (; row < count; row++)
+            filled += bids[row] == orderId || asks[row] == orderId ? quantities[row] : 0;
+        return filled;
+    }
+}
+
+template <typename Traits>
+BasicTradeLog<Traits>::BasicTradeLog(std::size_t capacity, std::pmr::memory_resource* resource)
+    : chunks_ {resource}
+{
+    // Value initialised, so every page of the preallocated chunks is touched here and not on append
+    chunks_.resize((capacity + ChunkRows - 1) / ChunkRows);
+}
+
+template <typename Traits>
+void BasicTradeLog<Traits>::Append(const Trades& trades, Side aggressor, Timestamp timestamp) {
+    // Keep the timestamp column sorted even if the clock steps back
+    if (size_ != 0)
+        timestamp = std::max(timestamp, chunks_[(size_ - 1) / ChunkRows].timestamps_[(size_ - 1) % ChunkRows]);
+
+    for (const auto& trade : trades) {
+        if (size_ / ChunkRows == chunks_.size())
+            chunks_.emplace_back();
+
+        auto& chunk = chunks_[size_ / ChunkRows];
+        std::size_t row = size_ % ChunkRows;
+        const auto& bid = trade.GetBidTrade();
+        const auto& ask = trade.GetAskTrade();
+
+        chunk.timestamps_[row] = timestamp;
+        chunk.prices_[row] = aggressor == Side::Buy ? ask.price_ : bid.price_;
+        chunk.quantities_[row] = bid.quantity_;
+        chunk.bidOrderIds_[row] = bid.orderId_;
+        chunk.askOrderIds_[row] = ask.orderId_;
+        chunk.aggressors_[row] = static_cast<std::uint8_t>(aggressor);
+        size_++;
+    }
+}
+
+template <typename Traits>
+template <typename Visitor>
+void BasicTradeLog<Traits>::ForEachRange(const TimeWindow& window, Visitor&& visitor) const {
+    std::size_t chunks = (size_ + ChunkRows - 1) / ChunkRows;
+
+    for (std::size_t i = 0; i < chunks; i++) {
+        const auto& chunk = chunks_[i];
+        auto begin = chunk.timestamps_.begin();
+        auto end = begin + (i + 1 < chunks ? ChunkRows : size_ - i * ChunkRows);
+
+        if (*(end - 1) < window.from_)
+            continue;
+        if (*begin >= window.to_)
+            break;
+
+        auto first = std::lower_bound(begin, end, window.from_);
+        auto last = std::lower_bound(first, end, window.to_);
+        if (first != last)
+            visitor(chunk, static_cast<std::size_t>(first - begin), static_cast<std::size_t>(last - begin));
+    }
+}
+
+template <typename Traits>
+Volume BasicTradeLog<Traits>::GetVolume(const TimeWindow& window) const {
+    Volume volume {};
+
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        volume += SumQuantities(chunk.quantities_.data() + first, last - first);
+    });
+    return volume;
+}
+
+template <typename Traits>
+std::optional<double> BasicTradeLog<Traits>::GetVwap(const TimeWindow& window) const {
+    Volume notional {}, volume {};
+
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        notional += SumNotional(chunk.prices_.data() + first, chunk.quantities_.data() + first, last - first);
+        volume += SumQuantities(chunk.quantities_.data() + first, last - first);
+    });
+
+    if (volume == 0)
+        return std::nullopt;
+    return static_cast<double>(notional) / static_cast<double>(volume);
+}
+
+template <typename Traits>
+auto BasicTradeLog<Traits>::GetVolumeByPrice(Price bucketSize, const TimeWindow& window) const -> std::vector<Bucket> {
+    if (bucketSize <= 0)
+        throw std::logic_error("Bucket size must be positive");
+
+    // Price range first, so the histogram below is a dense array indexed from the lowest bucket
+    std::optional<PriceRange> range;
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        auto [low, high] = GetPriceRange(chunk.prices_.data() + first, last - first);
+        range = range.has_value() ? PriceRange{std::min(range->low_, low), std::max(range->high_, high)} : PriceRange{low, high};
+    });
+
+    std::vector<Bucket> buckets;
+    if (!range.has_value())
+        return buckets;
+
+    // Floor towards negative infinity so negative prices land in the right bucket
+    Volume base = range->low_ / bucketSize * bucketSize;
+    if (base > range->low_)
+        base -= bucketSize;
+
+    // The scatter has no SIMD form without AVX-512 conflict detection. Over a narrow range it
+    // goes to single prices first and is folded into buckets after, saving a division per row.
+    std::vector<Volume> histogram(static_cast<std::size_t>((range->high_ - base) / bucketSize + 1));
+    auto span = static_cast<std::size_t>(range->high_ - range->low_ + 1);
+
+    if (span <= DenseSpanLimit) {
+        std::vector<Volume> prices(span);
+        ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+            for (std::size_t row = first; row < last; row++)
+                prices[static_cast<std::size_t>(chunk.prices_[row] - range->low_)] += chunk.quantities_[row];
+        });
+        for (std::size_t i = 0; i < span; i++)
+            histogram[static_cast<std::size_t>((range->low_ + static_cast<Volume>(i) - base) / bucketSize)] += prices[i];
+    } else {
+        ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+            for (std::size_t row = first; row < last; row++)
+                histogram[static_cast<std::size_t>((chunk.prices_[row] - base) / bucketSize)] += chunk.quantities_[row];
+        });
+    }
+
+    for (std::size_t i = 0; i < histogram.size(); i++)
+        if (histogram[i] != 0)
+            buckets.push_back(Bucket{static_cast<Price>(base + static_cast<Volume>(i) * bucketSize), histogram[i]});
+    return buckets;
+}
+
+template <typename Traits>
+auto BasicTradeLog<Traits>::GetBars(Timestamp interval, const TimeWindow& window) const -> std::vector<Bar> {
+    if (interval <= 0)
+        throw std::logic_error("Bar interval must be positive");
+
+    // Bars start at the window's start, or on the interval grid since the epoch for an open window
+    Timestamp origin = window.from_ == std::numeric_limits<Timestamp>::min() ? 0 : window.from_;
+    std::vector<Bar> bars;
+
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        const Price* prices = chunk.prices_.data();
+
+        while (first < last) {
+            Timestamp start = origin + (chunk.timestamps_[first] - origin) / interval * interval;
+            std::size_t end = static_cast<std::size_t>(std::lower_bound(chunk.timestamps_.begin() + first,
+                chunk.timestamps_.begin() + last, start + interval) - chunk.timestamps_.begin());
+
+            auto [low, high] = GetPriceRange(prices + first, end - first);
+            Volume volume = SumQuantities(chunk.quantities_.data() + first, end - first);
+
+            // A bar can straddle two chunks
+            if (!bars.empty() && bars.back().start_ == start) {
+                auto& bar = bars.back();
+                bar.high_ = std::max<Price>(bar.high_, static_cast<Price>(high));
+                bar.low_ = std::min<Price>(bar.low_, static_cast<Price>(low));
+                bar.close_ = prices[end - 1];
+                bar.volume_ += volume;
+            } else {
+                bars.push_back(Bar{start, prices[first], static_cast<Price>(high), static_cast<Price>(low), prices[end - 1], volume});
+            }
+            first = end;
+        }
+    });
+    return bars;
+}
+
+template <typename Traits>
+Volume BasicTradeLog<Traits>::GetFilledQuantity(OrderId orderId, const TimeWindow& window) const {
+    Volume filled {};
+
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        filled += SumMatching(chunk.bidOrderIds_.data() + first, chunk.askOrderIds_.data() + first,
+            chunk.quantities_.data() + first, last - first, orderId);
+    });
+    return filled;
+}
+
+template <typename Traits>
+std::unordered_map<OrderId, Volume> BasicTradeLog<Traits>::GetFillTotals(const TimeWindow& window) const {
+    std::unordered_map<OrderId, Volume> totals;
+
+    ForEachRange(window, [&](const Chunk& chunk, std::size_t first, std::size_t last) {
+        for (std::size_t row = first; row < last; row++) {
+            totals[chunk.bidOrderIds_[row]] += chunk.quantities_[row];
+            totals[chunk.askOrderIds_[row]] += chunk.quantities_[row];
+        }
+    });
+    return totals;
+}
+
+template class BasicTradeLog<DefaultTraits>;
+template class BasicTradeLog<WideQuantityTraits>;
+template class BasicTradeLog<CompactPriceTraits>;
\ No newline at end of file
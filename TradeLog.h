@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory_resource>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+#include "Datatypes.h"
+#include "Trade.h"
+
+/*
+Columnar log of every fill
+
+Rows are stored column by column in fixed size chunks: timestamp, execution price, quantity,
+aggressor side and both order ids. Chunks are allocated up front for the expected number of
+fills and the log only grows past that in whole chunks, so appending never moves a row.
+Timestamps never decrease, a time window maps to one contiguous row range per chunk.
+
+Queries reduce over whole columns with explicit std::experimental::simd kernels in 64 bit
+lanes (see TradeLog.cpp), GCC does not vectorise the plain loops at -O2. Time windows are
+half open, [from_, to_) in nanoseconds.
+*/
+
+using Timestamp = std::int64_t;     // Nanoseconds since the epoch
+using Volume = std::int64_t;        // Sum of quantities, wide enough for any session
+
+struct TimeWindow {
+    Timestamp from_ {std::numeric_limits<Timestamp>::min()};
+    Timestamp to_ {std::numeric_limits<Timestamp>::max()};
+};
+
+template <typename Traits>
+class BasicTradeLog {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using Trades = BasicTrades<Traits>;
+
+    static constexpr std::size_t ChunkRows = 4096;
+
+    struct Bar {
+        Timestamp start_;
+        Price open_;
+        Price high_;
+        Price low_;
+        Price close_;
+        Volume volume_;
+    };
+
+    struct Bucket {
+        Price price_;   // Lowest price of the bucket
+        Volume volume_;
+    };
+
+    explicit BasicTradeLog(std::size_t capacity = ChunkRows, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    BasicTradeLog(const BasicTradeLog&) = delete;       // Copy constructor
+    void operator=(const BasicTradeLog&) = delete;      // Copy assignment
+    BasicTradeLog(BasicTradeLog&&) = delete;            // Move constructor
+    void operator=(BasicTradeLog&&) = delete;           // Move assignment
+
+    // Fills of one incoming order, priced at the resting side
+    void Append(const Trades& trades, Side aggressor, Timestamp timestamp);
+    void Clear() { size_ = 0; }
+    std::size_t Size() const { return size_; }
+
+    Volume GetVolume(const TimeWindow& window = {}) const;
+    std::optional<double> GetVwap(const TimeWindow& window = {}) const;
+    std::vector<Bucket> GetVolumeByPrice(Price bucketSize, const TimeWindow& window = {}) const;
+    std::vector<Bar> GetBars(Timestamp interval, const TimeWindow& window) const;
+    Volume GetFilledQuantity(OrderId orderId, const TimeWindow& window = {}) const;
+    std::unordered_map<OrderId, Volume> GetFillTotals(const TimeWindow& window = {}) const;
+
+private:
+    struct Chunk {
+        std::array<Timestamp, ChunkRows> timestamps_;
+        std::array<Price, ChunkRows> prices_;
+        std::array<Quantity, ChunkRows> quantities_;
+        std::array<OrderId, ChunkRows> bidOrderIds_;
+        std::array<OrderId, ChunkRows> askOrderIds_;
+        std::array<std::uint8_t, ChunkRows> aggressors_;  // Side of the incoming order
+    };
+
+    std::pmr::deque<Chunk> chunks_;
+    std::size_t size_ {};
+
+    // Calls visitor(chunk, first, last) for every row range of the window
+    template <typename Visitor>
+    void ForEachRange(const TimeWindow& window, Visitor&& visitor) const;
+};
+
+extern template class BasicTradeLog<DefaultTraits>;
+extern template class BasicTradeLog<WideQuantityTraits>;
+extern template class BasicTradeLog<CompactPriceTraits>;
+
+using TradeLog = BasicTradeLog<DefaultTraits>;
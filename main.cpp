@@ -1,9 +1,88 @@
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
 #include "OrderBook.h"
 #include "InputHandler.h"
 #include "Interface.h"
+#include "MemoryArena.h"
+#include "Replay.h"
+#include "Stream.h"
 
-int main() {
-    Orderbook orderbook;
+/*
+Usage
+
+orderbook                                                   // Interactive
+orderbook --replay <directory|manifest> <output> [threads]  // Parallel replay of flow files
+          [--perf]                                          // Per-operation hardware counters
+orderbook --stream [path]                                   // Commands from stdin or a FIFO, acks and trades to stdout
+*/
+
+int Replay(std::vector<std::string_view> args) {
+    bool instrumented = std::erase(args, "--perf") > 0;
+
+    if (args.size() < 3) {
+        std::cerr << "Usage: --replay <directory|manifest> <output> [threads] [--perf]" << std::endl;
+        return 1;
+    }
+
+    std::size_t threads = args.size() > 3 ? std::stoul(std::string {args[3]}) : std::thread::hardware_concurrency();
+    ReplayDriver driver {threads};
+    driver.SetInstrumentation(instrumented);
+
+    auto start = std::chrono::steady_clock::now();
+    ReplaySummaries summaries;
+    try {
+        summaries = driver.Run(args[1], args[2]);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    ReplayDriver::PrintSummaries(summaries, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    if (instrumented)
+        driver.GetPerfStats().Print();
+    return 0;
+}
+
+int Stream(const std::vector<std::string_view>& args) {
+    int input = STDIN_FILENO;
+    if (args.size() > 1) {
+        input = open(std::string {args[1]}.c_str(), O_RDONLY);
+        if (input < 0) {
+            std::cerr << std::format("Cannot open {}", args[1]) << std::endl;
+            return 1;
+        }
+    }
+
+    HugePageArena arena {64 * 1024 * 1024};     // Must outlive the orderbook
+    Orderbook orderbook {&arena};
+    StreamDriver driver {input, STDOUT_FILENO};
+
+    StreamSummary summary;
+    try {
+        summary = driver.Run(orderbook);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    if (input != STDIN_FILENO)
+        close(input);
+
+    std::cerr << std::format("{} commands, {} trades in {:.3f}s, {:.0f} commands/s",
+        summary.commands_, summary.trades_, summary.seconds_, summary.commands_ / summary.seconds_) << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string_view> args(argv, argv + argc);
+    if (args.size() > 1 && args[1] == "--replay")
+        return Replay({args.begin() + 1, args.end()});
+    if (args.size() > 1 && args[1] == "--stream")
+        return Stream({args.begin() + 1, args.end()});
+
+    HugePageArena arena {64 * 1024 * 1024};     // Must outlive the orderbook
+    Orderbook orderbook {&arena};
     InputHandler handler;
     Interface interface;
 